@@ -0,0 +1,221 @@
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "baseline.hpp"
+#include "chip8.hpp"
+#include "debugger.hpp"
+#include "options.hpp"
+#include "window.hpp"
+
+using clockz = std::chrono::steady_clock;
+
+namespace {
+
+// Draws random font digits at random positions forever
+const std::uint8_t demo_rom[] = {
+    0xC0, 0x3F,  // RND V0, 0x3F
+    0xC1, 0x1F,  // RND V1, 0x1F
+    0xC2, 0x0F,  // RND V2, 0x0F
+    0xF2, 0x29,  // LD F, V2
+    0xD0, 0x15,  // DRW V0, V1, 5
+    0x12, 0x00,  // JP 0x200
+};
+
+struct Size {
+    int width;
+    int height;
+};
+
+struct Stats {
+    double min;
+    double median;
+    double p95;
+    double p99;
+    double max;
+};
+
+Stats stats(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&samples](const double q) {
+        return samples[std::min(samples.size() - 1, static_cast<std::size_t>(q * samples.size()))];
+    };
+    return {samples.front(), at(0.5), at(0.95), at(0.99), samples.back()};
+}
+
+// Run the ROM like Application does and keep the machine state from every frame
+std::vector<Chip8> record(Chip8 chip8, const int frames) {
+    std::vector<Chip8> recording;
+    recording.reserve(frames);
+
+    for (int f = 0; f < frames; ++f) {
+        for (int i = 0; i < 8 && chip8.valid(); ++i) {
+            chip8.step();
+        }
+        chip8.timers();
+        recording.push_back(chip8);
+    }
+
+    return recording;
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    int frames = 600;
+    double max_p95 = 0.0;
+    const char *baseline_path = nullptr;
+    double tolerance = 0.25;
+    Chip8 chip8;
+    bool loaded = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[i + 1]));
+            i++;
+        } else if (std::strcmp(argv[i], "--max-p95") == 0 && i + 1 < argc) {
+            max_p95 = std::atof(argv[i + 1]);
+            i++;
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[i + 1];
+            i++;
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atof(argv[i + 1]) / 100;
+            i++;
+        } else if (!loaded) {
+            if (!chip8.load(argv[i])) {
+                std::cerr << "Failed to load ROM " << argv[i] << std::endl;
+                return 2;
+            }
+            loaded = true;
+        } else {
+            std::cout << "Usage: bench-render [rom] [--frames <n>] [--max-p95 <us>] [--baseline <file> [--tolerance <percent>]]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    if (!loaded) {
+        chip8.load(demo_rom);
+    }
+
+    // No display or GPU needed, SDL_VIDEODRIVER in the environment still wins
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "SDL_Init() error: " << SDL_GetError() << std::endl;
+        return 2;
+    }
+
+    const auto recording = record(chip8, frames);
+    const Debugger debugger;
+    const std::vector<Size> sizes = {{640, 320}, {1024, 512}, {1920, 960}, {3840, 1920}};
+    auto stored = baseline_path ? baseline::read(baseline_path) : baseline::Values();
+    const bool update = baseline::update();
+    bool recorded = false;
+    bool missing = false;
+    bool failed = false;
+
+    try {
+        std::printf("%-6s %-6s %-10s %10s %10s %10s %10s %10s   (us per frame)\n",
+                    "debug",
+                    "border",
+                    "size",
+                    "min",
+                    "median",
+                    "p95",
+                    "p99",
+                    "max");
+
+        for (const bool debug : {false, true}) {
+            for (const bool borders : {true, false}) {
+                for (const auto &size : sizes) {
+                    // A fresh window so the backbuffer really is this size
+                    Window window("Chip8 bench", size.width, size.height);
+                    window.resize(size.width, size.height);
+                    options::borders = borders;
+                    options::debug = debug;
+
+                    std::vector<double> samples;
+                    samples.reserve(recording.size());
+
+                    // Same work as Application::render
+                    for (const auto &frame : recording) {
+                        const auto start = clockz::now();
+                        window.clear();
+                        window.render(frame);
+                        if (options::debug) {
+                            window.render_inputs(frame);
+                            window.render_debugger(frame, debugger);
+                        }
+                        window.present();
+                        const auto end = clockz::now();
+                        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+                    }
+
+                    const auto s = stats(samples);
+                    const std::string dims = std::to_string(size.width) + "x" + std::to_string(size.height);
+                    std::printf("%-6s %-6s %-10s %10.1f %10.1f %10.1f %10.1f %10.1f",
+                                debug ? "on" : "off",
+                                borders ? "on" : "off",
+                                dims.c_str(),
+                                s.min,
+                                s.median,
+                                s.p95,
+                                s.p99,
+                                s.max);
+
+                    if (max_p95 > 0.0 && s.p95 > max_p95) {
+                        failed = true;
+                    }
+
+                    // Compared on p95 like --max-p95, but against this machine's own history
+                    if (baseline_path) {
+                        const std::string name = std::string("p95_debug-") + (debug ? "on" : "off") + "_borders-" +
+                                                 (borders ? "on" : "off") + "_" + dims;
+                        const auto it = stored.find(name);
+                        if (it == stored.end() || update) {
+                            const bool first = it == stored.end() && !update;
+                            stored[name] = s.p95;
+                            recorded = true;
+                            missing |= first;
+                            std::printf(first ? "   no baseline, recorded" : "   recorded");
+                        } else if (s.p95 > it->second * (1 + tolerance)) {
+                            failed = true;
+                            std::printf("   over baseline %.1f", it->second);
+                        }
+                    }
+                    std::printf("\n");
+                }
+            }
+        }
+    } catch (const std::bad_alloc &ex) {
+        std::cerr << "Failed to create window: " << SDL_GetError() << std::endl;
+        SDL_Quit();
+        return 2;
+    }
+
+    SDL_Quit();
+
+    if (recorded && !baseline::write(baseline_path, stored)) {
+        std::cerr << "Failed to write baseline " << baseline_path << std::endl;
+        return 2;
+    }
+
+    if (failed) {
+        std::cerr << "p95 frame time over the limit" << std::endl;
+        return 1;
+    }
+
+    if (missing) {
+        std::cerr << "No baseline to compare against, recorded one in " << baseline_path << std::endl;
+        return baseline::missing;
+    }
+
+    return 0;
+}
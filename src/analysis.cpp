@@ -0,0 +1,235 @@
+#include "analysis.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+namespace analysis {
+
+namespace {
+
+// What's known about I on entry to an instruction
+constexpr int unvisited = -1;
+constexpr int unknown = -2;
+
+}  // namespace
+
+Result analyze(const std::span<const std::uint8_t> rom) {
+    std::array<std::uint8_t, 4096> ram = {};
+    std::copy_n(rom.begin(), std::min<std::size_t>(rom.size(), 4096 - 0x200), ram.begin() + 0x200);
+
+    Result result;
+    std::array<int, 4096> state;
+    state.fill(unvisited);
+    std::vector<int> todo;
+
+    // Revisit an instruction whenever what's known about I on entry gets weaker
+    const auto visit = [&](const int pc, const int i) {
+        if (pc < 0x200 || pc + 1 >= 4096) {
+            return;
+        }
+        if (state[pc] == unvisited) {
+            state[pc] = i;
+            todo.push_back(pc);
+        } else if (state[pc] != i && state[pc] != unknown) {
+            state[pc] = unknown;
+            todo.push_back(pc);
+        }
+    };
+
+    const auto mark_writes = [&](const int i, const int length) {
+        if (i == unknown) {
+            result.unknown_writes = true;
+            return;
+        }
+        for (int a = 0; a < length; ++a) {
+            result.writes.set((i + a) & 0xFFF);
+        }
+    };
+
+    // The interpreter keeps V0-VF, the stack and the display in RAM at 0x6A0-0x7FF and
+    // writes them on nearly every instruction, so code there is always self-modifying
+    for (int a = 0x06A0; a <= 0x07FF; ++a) {
+        result.writes.set(a);
+    }
+
+    visit(0x200, unknown);
+
+    while (!todo.empty()) {
+        const int pc = todo.back();
+        todo.pop_back();
+
+        const int i = state[pc];
+        result.starts.set(pc);
+        result.code.set(pc);
+        result.code.set(pc + 1);
+
+        const std::uint16_t opcode = (ram[pc] << 8) + ram[pc + 1];
+        const int nnn = opcode & 0x0FFF;
+        const int x = (opcode & 0x0F00) >> 8;
+
+        switch (opcode & 0xF000) {
+            case 0x0000:
+                if (opcode == 0x00E0) {
+                    visit(pc + 2, i);
+                } else if (opcode != 0x00EE) {
+                    visit(nnn, i);
+                }
+                break;
+            case 0x1000:
+                visit(nnn, i);
+                break;
+            case 0x2000:
+                // The subroutine might change I before coming back
+                visit(nnn, i);
+                visit(pc + 2, unknown);
+                break;
+            case 0x3000:
+            case 0x4000:
+            case 0x5000:
+            case 0x9000:
+            case 0xE000:
+                visit(pc + 2, i);
+                visit(pc + 4, i);
+                break;
+            case 0xA000:
+                visit(pc + 2, nnn);
+                break;
+            case 0xB000:
+                // V0 isn't known, but jump tables are usually a run of JPs
+                visit(nnn, i);
+                for (int a = nnn; a + 1 < 4096 && a < nnn + 256 && (ram[a] & 0xF0) == 0x10; a += 2) {
+                    visit(a, i);
+                }
+                break;
+            case 0xF000:
+                switch (opcode & 0xF0FF) {
+                    case 0xF01E:
+                    case 0xF029:
+                        visit(pc + 2, unknown);
+                        break;
+                    case 0xF033:
+                        mark_writes(i, 3);
+                        visit(pc + 2, i);
+                        break;
+                    case 0xF055:
+                        mark_writes(i, x + 1);
+                        visit(pc + 2, i);
+                        break;
+                    default:
+                        visit(pc + 2, i);
+                        break;
+                }
+                break;
+            default:
+                visit(pc + 2, i);
+                break;
+        }
+    }
+
+    return result;
+}
+
+std::string disassemble(const std::uint16_t opcode) {
+    const int nnn = opcode & 0x0FFF;
+    const int kk = opcode & 0x00FF;
+    const int x = (opcode & 0x0F00) >> 8;
+    const int y = (opcode & 0x00F0) >> 4;
+    const int n = opcode & 0x000F;
+
+    char buffer[32];
+    const auto format = [&buffer](const char *fmt, const auto... args) {
+        std::snprintf(buffer, sizeof(buffer), fmt, args...);
+        return std::string(buffer);
+    };
+
+    switch (opcode & 0xF000) {
+        case 0x0000:
+            if (opcode == 0x00E0) {
+                return "CLS";
+            } else if (opcode == 0x00EE) {
+                return "RET";
+            }
+            return format("SYS 0x%03X", nnn);
+        case 0x1000:
+            return format("JP 0x%03X", nnn);
+        case 0x2000:
+            return format("CALL 0x%03X", nnn);
+        case 0x3000:
+            return format("SE V%X, 0x%02X", x, kk);
+        case 0x4000:
+            return format("SNE V%X, 0x%02X", x, kk);
+        case 0x6000:
+            return format("LD V%X, 0x%02X", x, kk);
+        case 0x7000:
+            return format("ADD V%X, 0x%02X", x, kk);
+        case 0xA000:
+            return format("LD I, 0x%03X", nnn);
+        case 0xB000:
+            return format("JP V0, 0x%03X", nnn);
+        case 0xC000:
+            return format("RND V%X, 0x%02X", x, kk);
+        case 0xD000:
+            return format("DRW V%X, V%X, %d", x, y, n);
+        default:
+            break;
+    }
+
+    switch (opcode & 0xF0FF) {
+        case 0xE09E:
+            return format("SKP V%X", x);
+        case 0xE0A1:
+            return format("SKNP V%X", x);
+        case 0xF007:
+            return format("LD V%X, DT", x);
+        case 0xF00A:
+            return format("LD V%X, K", x);
+        case 0xF015:
+            return format("LD DT, V%X", x);
+        case 0xF018:
+            return format("LD ST, V%X", x);
+        case 0xF01E:
+            return format("ADD I, V%X", x);
+        case 0xF029:
+            return format("LD F, V%X", x);
+        case 0xF033:
+            return format("LD B, V%X", x);
+        case 0xF055:
+            return format("LD [I], V%X", x);
+        case 0xF065:
+            return format("LD V%X, [I]", x);
+        default:
+            break;
+    }
+
+    switch (opcode & 0xF00F) {
+        case 0x5000:
+            return format("SE V%X, V%X", x, y);
+        case 0x8000:
+            return format("LD V%X, V%X", x, y);
+        case 0x8001:
+            return format("OR V%X, V%X", x, y);
+        case 0x8002:
+            return format("AND V%X, V%X", x, y);
+        case 0x8003:
+            return format("XOR V%X, V%X", x, y);
+        case 0x8004:
+            return format("ADD V%X, V%X", x, y);
+        case 0x8005:
+            return format("SUB V%X, V%X", x, y);
+        case 0x8006:
+            return format("SHR V%X, V%X", x, y);
+        case 0x8007:
+            return format("SUBN V%X, V%X", x, y);
+        case 0x800E:
+            return format("SHL V%X, V%X", x, y);
+        case 0x9000:
+            return format("SNE V%X, V%X", x, y);
+        default:
+            break;
+    }
+
+    return format("DW 0x%04X", opcode);
+}
+
+}  // namespace analysis
@@ -0,0 +1,34 @@
+#ifndef ANALYSIS_HPP
+#define ANALYSIS_HPP
+
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace analysis {
+
+struct Result {
+    // Bytes reachable as instructions by following control flow from 0x200
+    std::bitset<4096> code;
+    // Addresses instructions were decoded at
+    std::bitset<4096> starts;
+    // Bytes Fx33 and Fx55 may write to, plus the registers, stack and display
+    std::bitset<4096> writes;
+    // Some Fx33 or Fx55 writes to an I that couldn't be worked out, so anything might be written
+    bool unknown_writes = false;
+
+    // Whether the ROM might write over its own code
+    [[nodiscard]] bool self_modifying() const {
+        return unknown_writes || (code & writes).any();
+    }
+};
+
+[[nodiscard]] Result analyze(const std::span<const std::uint8_t> rom);
+
+// e.g. "LD V3, 0x10"
+[[nodiscard]] std::string disassemble(const std::uint16_t opcode);
+
+}  // namespace analysis
+
+#endif
@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "analysis.hpp"
+#include "chip8.hpp"
+
+int main(const int argc, const char **argv) {
+    if (argc < 2) {
+        std::cout << "No path to ROM specified" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::uint8_t> rom;
+    if (!read_rom(argv[1], rom)) {
+        std::cerr << "Failed to load ROM " << argv[1] << std::endl;
+        return 2;
+    }
+
+    const auto result = analysis::analyze(rom);
+    const int end = 0x200 + rom.size();
+
+    // Listing, code is disassembled and anything else is dumped as data
+    int a = 0x200;
+    while (a < end) {
+        if (result.starts.test(a)) {
+            const std::uint16_t opcode = (rom[a - 0x200] << 8) + (a + 1 < end ? rom[a + 1 - 0x200] : 0);
+            const bool written = result.writes.test(a) || result.writes.test(a + 1);
+            std::printf("%03X  %04X  %s%s\n",
+                        a,
+                        opcode,
+                        analysis::disassemble(opcode).c_str(),
+                        written ? "  ; written" : "");
+            a += 2;
+        } else if (result.code.test(a)) {
+            a++;
+        } else {
+            std::printf("%03X  ", a);
+            for (int i = 0; i < 8 && a < end && !result.code.test(a); ++i, ++a) {
+                std::printf("%02X ", rom[a - 0x200]);
+            }
+            std::printf(" DB\n");
+        }
+    }
+
+    int code = 0;
+    for (int i = 0x200; i < end; ++i) {
+        code += result.code.test(i);
+    }
+
+    std::cout << std::endl;
+    std::cout << "Code bytes " << code << std::endl;
+    std::cout << "Data bytes " << end - 0x200 - code << std::endl;
+    std::cout << "Self-modifying " << (result.self_modifying() ? "maybe" : "no");
+    if (result.unknown_writes) {
+        std::cout << " (writes through an unknown I)";
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
@@ -16,6 +16,23 @@ bool Application::load_rom(const char *path) {
     return chip8_.load(path);
 }
 
+bool Application::load_rom(const pack::Entry &entry) {
+    if (entry.clock == 0) {
+        return false;
+    }
+    step_time_ = std::chrono::microseconds(1000000 / entry.clock);
+    return chip8_.load(entry.rom);
+}
+
+void Application::trace(const char *path) {
+    assert(path);
+    tracer_ = std::make_unique<Tracer>(path);
+}
+
+Debugger &Application::debugger() {
+    return debugger_;
+}
+
 void Application::step() {
     const std::uint8_t *keystate = SDL_GetKeyboardState(NULL);
 
@@ -38,7 +55,18 @@ void Application::step() {
         chip8_.set_key(Input::Key_V, keystate[SDL_SCANCODE_V]);
     }
 
-    chip8_.step();
+    // The debugger and tracer each get their own instantiation of Chip8::step,
+    // and one for both so turning the debugger on doesn't leave gaps in a trace
+    if (options::debug && tracer_) {
+        BothHooks<Debugger, Tracer> hooks{debugger_, *tracer_};
+        chip8_.step(hooks);
+    } else if (options::debug) {
+        chip8_.step(debugger_);
+    } else if (tracer_) {
+        chip8_.step(*tracer_);
+    } else {
+        chip8_.step();
+    }
 }
 
 void Application::events() {
@@ -60,6 +88,7 @@ void Application::events() {
                         break;
                     case SDLK_SPACE:
                         paused_ = !paused_;
+                        debugger_.resume();
                         break;
                     case SDLK_F1:
                         options::debug = !options::debug;
@@ -70,6 +99,11 @@ void Application::events() {
                     case SDLK_F3:
                         options::borders = !options::borders;
                         break;
+                    default:
+                        if (options::debug) {
+                            debug_events(event.key.keysym.sym);
+                        }
+                        break;
                 }
                 break;
             case SDL_WINDOWEVENT:
@@ -87,6 +121,40 @@ void Application::events() {
     }
 }
 
+void Application::debug_events(const SDL_Keycode key) {
+    switch (key) {
+        // Continue
+        case SDLK_F5:
+            debugger_.resume();
+            paused_ = false;
+            break;
+        // Step into
+        case SDLK_F6:
+            if (paused_) {
+                debugger_.resume();
+                step();
+            }
+            break;
+        // Step over
+        case SDLK_F7:
+            if (paused_) {
+                debugger_.resume();
+                if (debugger_.step_over(chip8_)) {
+                    paused_ = false;
+                } else {
+                    step();
+                }
+            }
+            break;
+        // Toggle breakpoint
+        case SDLK_F9:
+            debugger_.toggle_breakpoint(chip8_.pc());
+            break;
+        default:
+            break;
+    }
+}
+
 void Application::render() {
     window_.clear();
     window_.render(chip8_);
@@ -99,6 +167,8 @@ void Application::render() {
     if (options::debug) {
         // Show pressed keys
         window_.render_inputs(chip8_);
+        // Show registers
+        window_.render_debugger(chip8_, debugger_);
     }
 
     window_.present();
@@ -110,10 +180,19 @@ void Application::update() {
     events();
 
     if (!paused_) {
-        // Keep at 500hz
-        while (last_step_ + std::chrono::milliseconds(2) <= now) {
-            step();
-            last_step_ += std::chrono::milliseconds(2);
+        // Keep at 500hz unless the ROM asked for something else
+        while (last_step_ + step_time_ <= now) {
+            // Breakpoints stop before their instruction runs
+            if (!options::debug || !debugger_.check_breakpoint(chip8_)) {
+                step();
+                last_step_ += step_time_;
+            }
+
+            if (debugger_.hit()) {
+                std::cout << debugger_.reason() << std::endl;
+                paused_ = true;
+                break;
+            }
         }
 
         // Keep at 60hz
@@ -2,8 +2,12 @@
 #define APPLICATION_HPP
 
 #include <chrono>
+#include <memory>
 #include "chip8.hpp"
+#include "debugger.hpp"
 #include "options.hpp"
+#include "pack.hpp"
+#include "trace.hpp"
 #include "window.hpp"
 
 using clockz = std::chrono::high_resolution_clock;
@@ -16,8 +20,16 @@ class Application {
 
     bool load_rom(const char *path);
 
+    bool load_rom(const pack::Entry &entry);
+
+    void trace(const char *path);
+
+    [[nodiscard]] Debugger &debugger();
+
     void step();
 
+    void debug_events(const SDL_Keycode key);
+
     void render();
 
     void events();
@@ -27,6 +39,9 @@ class Application {
    private:
     Window window_;
     Chip8 chip8_;
+    std::unique_ptr<Tracer> tracer_;
+    Debugger debugger_;
+    std::chrono::microseconds step_time_ = std::chrono::milliseconds(2);
     std::chrono::time_point<clockz> last_step_;
     std::chrono::time_point<clockz> last_timer_;
     std::chrono::time_point<clockz> last_render_;
@@ -1,4 +1,6 @@
 #include "chip8.hpp"
+#include "debugger.hpp"
+#include "trace.hpp"
 #include <cassert>
 #include <cstring>
 #include <iostream>
@@ -27,15 +29,55 @@ Chip8::Chip8() {
     std::copy(std::cbegin(fontset), std::cend(fontset), std::begin(ram_));
 }
 
-bool Chip8::load(const char *path) {
+Chip8::Chip8(const Chip8 &other)
+    : ram_(other.ram_),
+      i_(other.i_),
+      pc_(other.pc_),
+      sp_(other.sp_),
+      dt_(other.dt_),
+      st_(other.st_),
+      keys_(other.keys_),
+      rng_(other.rng_) {
+}
+
+Chip8 &Chip8::operator=(const Chip8 &other) {
+    ram_ = other.ram_;
+    i_ = other.i_;
+    pc_ = other.pc_;
+    sp_ = other.sp_;
+    dt_ = other.dt_;
+    st_ = other.st_;
+    keys_ = other.keys_;
+    rng_ = other.rng_;
+    return *this;
+}
+
+bool read_rom(const char *path, std::vector<std::uint8_t> &rom) {
     assert(path);
 
     FILE *file = fopen(path, "rb");
     if (!file) {
         return false;
     }
-    fread(ram_.data() + 0x200, 4096 - 0x200, 1, file);
+
+    rom.resize(4096 - 0x200);
+    rom.resize(fread(rom.data(), 1, rom.size(), file));
+    // Reject read errors and ROMs too big to fit
+    const bool ok = !ferror(file) && fgetc(file) == EOF;
     fclose(file);
+    return ok;
+}
+
+bool Chip8::load(const char *path) {
+    std::vector<std::uint8_t> rom;
+    return read_rom(path, rom) && load(rom);
+}
+
+bool Chip8::load(const std::span<const std::uint8_t> rom) {
+    if (rom.size() > 4096 - 0x200) {
+        return false;
+    }
+    std::copy(std::cbegin(rom), std::cend(rom), std::begin(ram_) + 0x200);
     return true;
 }
 
@@ -53,7 +95,52 @@ bool Chip8::pixel(const int x, const int y) const {
     return (ram_[0x0700 + (x / 8) + (8 * y)] >> (7 - (x % 8))) & 1;
 }
 
+std::span<const std::uint8_t, 256> Chip8::display() const {
+    return std::span<const std::uint8_t, 256>(&ram_[0x0700], 8 * 32);
+}
+
+bool Chip8::valid() const {
+    if (pc_ + 1 >= 4096 || i_ + 16 > 4096 || sp_ < 1 || sp_ > 0x6CF) {
+        return false;
+    }
+
+    // Everything step() has no case for
+    const std::uint16_t opcode = (ram_[pc_] << 8) + ram_[pc_ + 1];
+    switch (opcode & 0xF000) {
+        case 0x5000:
+        case 0x9000:
+            return (opcode & 0x000F) == 0;
+        case 0x8000:
+            return (opcode & 0x000F) <= 0x7 || (opcode & 0x000F) == 0xE;
+        case 0xE000:
+            return (opcode & 0x00FF) == 0x9E || (opcode & 0x00FF) == 0xA1;
+        case 0xF000:
+            switch (opcode & 0x00FF) {
+                case 0x07:
+                case 0x0A:
+                case 0x15:
+                case 0x18:
+                case 0x1E:
+                case 0x29:
+                case 0x33:
+                case 0x55:
+                case 0x65:
+                    return true;
+                default:
+                    return false;
+            }
+        default:
+            return true;
+    }
+}
+
 void Chip8::step() {
+    NoHooks hooks;
+    step(hooks);
+}
+
+template <typename Hooks>
+void Chip8::step(Hooks &hooks) {
     assert(pc_ + 1 < 4096);
     assert(i_ <= 0xFFF);
     assert(sp_ <= 0x6CF);
@@ -65,6 +152,8 @@ void Chip8::step() {
     const std::uint8_t y = (opcode & 0x00F0) >> 4;
     const std::uint8_t n = (opcode & 0x000F);
 
+    hooks.before(*this, opcode);
+
     // Instructions
     switch (opcode & 0xF000) {
         case 0x0000: {
@@ -75,6 +164,7 @@ void Chip8::step() {
             }
             // 00E0 - CLS
             else if (opcode == 0x00E0) {
+                hooks.write(0x0700, 8 * 32);
                 memset(&ram_[0x0700], 0, 8 * 32);
                 pc_ += 2;
             }
@@ -91,6 +181,7 @@ void Chip8::step() {
         }
         // 2nnn - CALL addr
         case 0x2000: {
+            hooks.write(sp_ - 1, 2);
             ram_[sp_] = pc_ & 0x00FF;
             ram_[sp_ - 1] = (pc_ & 0xFF00) >> 8;
             sp_ -= 2;
@@ -137,7 +228,11 @@ void Chip8::step() {
         // Cxkk - RND Vx, byte
         case 0xC000: {
             assert(x < 16);
-            v_[x] = (rand() % 256) & kk;
+            // xorshift32
+            rng_ ^= rng_ << 13;
+            rng_ ^= rng_ >> 17;
+            rng_ ^= rng_ << 5;
+            v_[x] = (rng_ >> 24) & kk;
             pc_ += 2;
             break;
         }
@@ -154,10 +249,12 @@ void Chip8::step() {
                 const std::uint8_t right = ram_[i_ + a] << (8 - xpos % 8);
 
                 const int idx_left = 0x0700 + xpos / 8 + 8 * ypos;
+                hooks.write(idx_left, 1);
                 v_[0xF] |= ram_[idx_left] & left;
                 ram_[idx_left] ^= left;
 
                 const int idx_right = 0x0700 + (xpos + 8) / 8 + 8 * ypos;
+                hooks.write(idx_right, 1);
                 v_[0xF] |= ram_[idx_right] & right;
                 ram_[idx_right] ^= right;
             }
@@ -174,15 +271,14 @@ void Chip8::step() {
                 // Ex9E - SKP Vx
                 case 0xE09E: {
                     assert(x < 16);
-                    assert(v_[x] < 16);
-                    pc_ += keys_[v_[x]] == true ? 4 : 2;
+                    // Only the low nibble picks a key, anything else would read past keys_
+                    pc_ += keys_[v_[x] & 0xF] == true ? 4 : 2;
                     break;
                 }
                 // ExA1 - SKNP Vx
                 case 0xE0A1: {
                     assert(x < 16);
-                    assert(v_[x] < 16);
-                    pc_ += keys_[v_[x]] != true ? 4 : 2;
+                    pc_ += keys_[v_[x] & 0xF] != true ? 4 : 2;
                     break;
                 }
                 default: {
@@ -244,6 +340,7 @@ void Chip8::step() {
                 case 0xF033: {
                     assert(x < 16);
                     assert(i_ + 2 < 4096);
+                    hooks.write(i_, 3);
                     ram_[i_ + 0] = (v_[x] / 100) % 10;
                     ram_[i_ + 1] = (v_[x] / 10) % 10;
                     ram_[i_ + 2] = (v_[x] / 1) % 10;
@@ -254,6 +351,7 @@ void Chip8::step() {
                 case 0xF055: {
                     assert(x < 16);
                     assert(i_ + x < 4096);
+                    hooks.write(i_, x + 1);
                     for (int a = 0; a <= x; ++a) {
                         ram_[i_ + a] = v_[a];
                     }
@@ -365,6 +463,39 @@ void Chip8::step() {
             }
             break;
     }
+
+    hooks.after(*this);
+}
+
+void Chip8::seed(const std::uint32_t seed) {
+    // xorshift gets stuck at zero
+    rng_ = seed ? seed : 0x2545F491;
+}
+
+std::uint64_t Chip8::digest() const {
+    // FNV-1a
+    std::uint64_t hash = 0xCBF29CE484222325;
+    const auto add = [&hash](const std::uint8_t byte) {
+        hash = (hash ^ byte) * 0x100000001B3;
+    };
+
+    for (const auto byte : ram_) {
+        add(byte);
+    }
+    for (const auto n : {i_, pc_, sp_}) {
+        add(n & 0xFF);
+        add(n >> 8);
+    }
+    add(dt_);
+    add(st_);
+    for (const auto key : keys_) {
+        add(key);
+    }
+    for (int shift = 0; shift < 32; shift += 8) {
+        add((rng_ >> shift) & 0xFF);
+    }
+
+    return hash;
 }
 
 void Chip8::timers() {
@@ -382,3 +513,8 @@ void Chip8::timers() {
         st_--;
     }
 }
+
+template void Chip8::step<NoHooks>(NoHooks &);
+template void Chip8::step<Tracer>(Tracer &);
+template void Chip8::step<Debugger>(Debugger &);
+template void Chip8::step<BothHooks<Debugger, Tracer>>(BothHooks<Debugger, Tracer> &);
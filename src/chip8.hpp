@@ -3,6 +3,8 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 enum class Input
 {
@@ -24,22 +26,113 @@ enum class Input
     Key_V = 0xF,
 };
 
+// Hex digit sprites, 5 bytes each, loaded at 0x000
+extern const std::array<std::uint8_t, 80> fontset;
+
+// Reads a whole ROM file, false on read errors or if it won't fit above 0x200
+bool read_rom(const char *path, std::vector<std::uint8_t> &rom);
+
+class Chip8;
+
+// Callbacks made by Chip8::step(), the default does nothing and compiles away
+struct NoHooks {
+    void before(const Chip8 &, const std::uint16_t) {
+    }
+
+    void write(const int, const int) {
+    }
+
+    void after(const Chip8 &) {
+    }
+};
+
+// Runs two sets of hooks on the same step, in order
+template <typename First, typename Second>
+struct BothHooks {
+    First &first;
+    Second &second;
+
+    void before(const Chip8 &chip8, const std::uint16_t opcode) {
+        first.before(chip8, opcode);
+        second.before(chip8, opcode);
+    }
+
+    void write(const int address, const int length) {
+        first.write(address, length);
+        second.write(address, length);
+    }
+
+    void after(const Chip8 &chip8) {
+        first.after(chip8);
+        second.after(chip8);
+    }
+};
+
 class Chip8 {
    public:
     [[nodiscard]] Chip8();
 
+    // v_ points into ram_ so has to be fixed up on copy
+    [[nodiscard]] Chip8(const Chip8 &other);
+
+    Chip8 &operator=(const Chip8 &other);
+
     bool load(const char *path);
 
+    bool load(const std::span<const std::uint8_t> rom);
+
     void step();
 
+    template <typename Hooks>
+    void step(Hooks &hooks);
+
     [[nodiscard]] bool pixel(const int x, const int y) const;
 
+    [[nodiscard]] std::span<const std::uint8_t, 256> display() const;
+
     void set_key(const Input a, const bool s);
 
     [[nodiscard]] bool get_key(const Input a) const;
 
     void timers();
 
+    // Cxkk draws from a per-machine generator so runs are reproducible
+    void seed(const std::uint32_t seed);
+
+    // Hash of the whole machine state
+    [[nodiscard]] std::uint64_t digest() const;
+
+    // Whether the next step() stays within RAM and the stack, and decodes to a known instruction
+    [[nodiscard]] bool valid() const;
+
+    [[nodiscard]] std::uint16_t pc() const {
+        return pc_;
+    }
+
+    [[nodiscard]] std::uint16_t i() const {
+        return i_;
+    }
+
+    [[nodiscard]] std::uint16_t sp() const {
+        return sp_;
+    }
+
+    [[nodiscard]] std::uint8_t dt() const {
+        return dt_;
+    }
+
+    [[nodiscard]] std::uint8_t st() const {
+        return st_;
+    }
+
+    [[nodiscard]] std::uint8_t v(const int x) const {
+        return v_[x];
+    }
+
+    [[nodiscard]] const std::array<std::uint8_t, 4096> &ram() const {
+        return ram_;
+    }
+
    private:
     // RAM
     std::array<std::uint8_t, 4096> ram_ = {};
@@ -53,6 +146,8 @@ class Chip8 {
     std::uint8_t st_ = 0;
     // Keys
     std::array<bool, 16> keys_ = {};
+    // Random number generator state
+    std::uint32_t rng_ = 0x2545F491;
 };
 
 #endif
@@ -0,0 +1,264 @@
+#include "debugger.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+std::string hex(const int n) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "0x%03X", n);
+    return buffer;
+}
+
+bool parse_number(const std::string &text, int &n) {
+    try {
+        std::size_t used = 0;
+        n = std::stoi(text, &used, 0);
+        return used == text.size();
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+int read(const Chip8 &chip8, const Debugger::Register reg) {
+    switch (reg) {
+        case Debugger::Register::I:
+            return chip8.i();
+        case Debugger::Register::SP:
+            return chip8.sp();
+        case Debugger::Register::DT:
+            return chip8.dt();
+        case Debugger::Register::ST:
+            return chip8.st();
+        case Debugger::Register::PC:
+            return chip8.pc();
+        default:
+            return chip8.v(static_cast<int>(reg));
+    }
+}
+
+bool compare(const int a, const Debugger::Compare op, const int b) {
+    switch (op) {
+        case Debugger::Compare::Equal:
+            return a == b;
+        case Debugger::Compare::NotEqual:
+            return a != b;
+        case Debugger::Compare::Less:
+            return a < b;
+        case Debugger::Compare::LessEqual:
+            return a <= b;
+        case Debugger::Compare::Greater:
+            return a > b;
+        case Debugger::Compare::GreaterEqual:
+            return a >= b;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+void Debugger::toggle_breakpoint(const std::uint16_t address) {
+    breakpoints_.flip(address & 0xFFF);
+}
+
+void Debugger::add_breakpoint(const std::uint16_t address) {
+    breakpoints_.set(address & 0xFFF);
+}
+
+bool Debugger::add_breakpoint(const std::string &text) {
+    int address = 0;
+    if (!parse_number(text, address) || address < 0 || address > 0xFFF) {
+        return false;
+    }
+
+    add_breakpoint(address);
+    return true;
+}
+
+bool Debugger::breakpoint(const std::uint16_t address) const {
+    return breakpoints_.test(address & 0xFFF);
+}
+
+void Debugger::add_watchpoint(const std::uint16_t start, const std::uint16_t end) {
+    assert(start <= end);
+    for (int a = start; a <= end && a < 4096; ++a) {
+        watched_.set(a);
+    }
+    if (start <= 0x06AF && end >= 0x06A0) {
+        watch_v_ = true;
+    }
+}
+
+bool Debugger::add_watchpoint(const std::string &text) {
+    if (text == "display") {
+        add_watchpoint(0x0700, 0x07FF);
+        return true;
+    } else if (text == "stack") {
+        add_watchpoint(0x06B0, 0x06CF);
+        return true;
+    }
+
+    const auto dash = text.find('-');
+    int start = 0;
+    int end = 0;
+    if (dash == std::string::npos) {
+        if (!parse_number(text, start)) {
+            return false;
+        }
+        end = start;
+    } else if (!parse_number(text.substr(0, dash), start) || !parse_number(text.substr(dash + 1), end)) {
+        return false;
+    }
+
+    if (start < 0 || end > 0xFFF || start > end) {
+        return false;
+    }
+
+    add_watchpoint(start, end);
+    return true;
+}
+
+bool Debugger::add_condition(const std::string &text) {
+    // Longest operators first so "<=" isn't read as "<"
+    const std::array<std::pair<const char *, Compare>, 6> ops = {{
+        {"==", Compare::Equal},
+        {"!=", Compare::NotEqual},
+        {"<=", Compare::LessEqual},
+        {">=", Compare::GreaterEqual},
+        {"<", Compare::Less},
+        {">", Compare::Greater},
+    }};
+
+    for (const auto &[op, cmp] : ops) {
+        const auto pos = text.find(op);
+        if (pos == std::string::npos) {
+            continue;
+        }
+
+        std::string name = text.substr(0, pos);
+        std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char c) {
+            return std::toupper(c);
+        });
+
+        Register reg;
+        if (name == "I") {
+            reg = Register::I;
+        } else if (name == "SP") {
+            reg = Register::SP;
+        } else if (name == "DT") {
+            reg = Register::DT;
+        } else if (name == "ST") {
+            reg = Register::ST;
+        } else if (name == "PC") {
+            reg = Register::PC;
+        } else if (name.size() == 2 && name[0] == 'V' && std::isxdigit(name[1])) {
+            reg = static_cast<Register>(std::stoi(name.substr(1), nullptr, 16));
+        } else {
+            return false;
+        }
+
+        int value = 0;
+        if (!parse_number(text.substr(pos + std::string(op).size()), value)) {
+            return false;
+        }
+
+        conditions_.push_back({reg, cmp, value, text});
+        return true;
+    }
+
+    return false;
+}
+
+bool Debugger::step_over(const Chip8 &chip8) {
+    const std::uint16_t opcode = (chip8.ram()[chip8.pc() & 0xFFF] << 8) + chip8.ram()[(chip8.pc() + 1) & 0xFFF];
+    if ((opcode & 0xF000) != 0x2000) {
+        return false;
+    }
+
+    // Matching the stack pointer too means recursive calls don't stop early
+    over_ = true;
+    over_pc_ = chip8.pc() + 2;
+    over_sp_ = chip8.sp();
+    return true;
+}
+
+bool Debugger::check_breakpoint(const Chip8 &chip8) {
+    const bool skip = skip_;
+    skip_ = false;
+    if (!skip && breakpoints_.test(chip8.pc() & 0xFFF)) {
+        stop("Breakpoint " + hex(chip8.pc()));
+        return true;
+    }
+    return false;
+}
+
+void Debugger::resume() {
+    skip_ = true;
+    hit_ = false;
+    reason_.clear();
+}
+
+bool Debugger::hit() const {
+    return hit_;
+}
+
+const std::string &Debugger::reason() const {
+    return reason_;
+}
+
+void Debugger::stop(const std::string &reason) {
+    if (!hit_) {
+        hit_ = true;
+        reason_ = reason;
+    }
+}
+
+void Debugger::before(const Chip8 &chip8, const std::uint16_t) {
+    if (watch_v_) {
+        for (int x = 0; x < 16; ++x) {
+            v_[x] = chip8.v(x);
+        }
+    }
+    written_ = -1;
+}
+
+void Debugger::write(const int address, const int length) {
+    for (int a = 0; a < length && written_ < 0; ++a) {
+        if (watched_.test((address + a) & 0xFFF)) {
+            written_ = (address + a) & 0xFFF;
+        }
+    }
+}
+
+void Debugger::after(const Chip8 &chip8) {
+    if (watch_v_ && written_ < 0) {
+        for (int x = 0; x < 16; ++x) {
+            if (chip8.v(x) != v_[x] && watched_.test(0x06A0 + x)) {
+                written_ = 0x06A0 + x;
+                break;
+            }
+        }
+    }
+
+    if (written_ >= 0) {
+        stop("Watchpoint " + hex(written_));
+    }
+
+    if (over_ && chip8.pc() == over_pc_ && chip8.sp() == over_sp_) {
+        over_ = false;
+        stop("Stepped over " + hex(over_pc_ - 2));
+    }
+
+    // Conditions only trigger when they become true
+    for (auto &condition : conditions_) {
+        const bool now = compare(read(chip8, condition.reg), condition.compare, condition.value);
+        if (now && !condition.last) {
+            stop("Condition " + condition.text);
+        }
+        condition.last = now;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef DEBUGGER_HPP
+#define DEBUGGER_HPP
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "chip8.hpp"
+
+// Step hooks checking breakpoints, watchpoints and register conditions
+class Debugger {
+   public:
+    enum class Register
+    {
+        V0 = 0x0,
+        VF = 0xF,
+        I,
+        SP,
+        DT,
+        ST,
+        PC,
+    };
+
+    enum class Compare
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+    };
+
+    struct Condition {
+        Register reg;
+        Compare compare;
+        int value;
+        std::string text;
+        bool last = false;
+    };
+
+    void toggle_breakpoint(const std::uint16_t address);
+
+    void add_breakpoint(const std::uint16_t address);
+
+    // "0x2A4", returns false unless it's a whole number within RAM
+    bool add_breakpoint(const std::string &text);
+
+    [[nodiscard]] bool breakpoint(const std::uint16_t address) const;
+
+    // Call before stepping, stops if the instruction at pc has a breakpoint.
+    // The first check after resume() lets it run so continuing doesn't stop straight away.
+    bool check_breakpoint(const Chip8 &chip8);
+
+    // Watch writes to [start, end]
+    void add_watchpoint(const std::uint16_t start, const std::uint16_t end);
+
+    // "0x700-0x7FF", "0x6A4", "display" or "stack"
+    bool add_watchpoint(const std::string &text);
+
+    // "V3==0x10", "I>=0x300", "SP<0x6B0" ...
+    bool add_condition(const std::string &text);
+
+    // Arm a temporary breakpoint after the CALL at pc, returns false if pc isn't a CALL
+    bool step_over(const Chip8 &chip8);
+
+    void resume();
+
+    [[nodiscard]] bool hit() const;
+
+    [[nodiscard]] const std::string &reason() const;
+
+    void before(const Chip8 &chip8, const std::uint16_t opcode);
+
+    void write(const int address, const int length);
+
+    void after(const Chip8 &chip8);
+
+   private:
+    void stop(const std::string &reason);
+
+    std::bitset<4096> breakpoints_;
+    std::bitset<4096> watched_;
+    std::vector<Condition> conditions_;
+    // Registers live in RAM but aren't written through write()
+    bool watch_v_ = false;
+    std::array<std::uint8_t, 16> v_ = {};
+    // Step over
+    bool over_ = false;
+    std::uint16_t over_pc_ = 0;
+    std::uint16_t over_sp_ = 0;
+    // Resuming from a breakpoint
+    bool skip_ = false;
+    // Write that triggered a watchpoint, if any
+    int written_ = -1;
+    bool hit_ = false;
+    std::string reason_;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "engine.hpp"
+#include "debugger.hpp"
+#include "trace.hpp"
+
+namespace {
+
+// Runs Chip8::step with a given set of hooks, they must not change behaviour
+template <typename Hooks>
+class HookedEngine final : public Engine {
+   public:
+    template <typename... Args>
+    [[nodiscard]] explicit HookedEngine(const char *name, Args &&...args)
+        : name_(name), hooks_(std::forward<Args>(args)...) {
+    }
+
+    std::string name() const override {
+        return name_;
+    }
+
+    void set_state(const Chip8 &chip8) override {
+        chip8_ = chip8;
+    }
+
+    Chip8 state() const override {
+        return chip8_;
+    }
+
+    std::uint64_t digest() const override {
+        return chip8_.digest();
+    }
+
+    bool valid() const override {
+        return chip8_.valid();
+    }
+
+    void step() override {
+        chip8_.step(hooks_);
+    }
+
+    void timers() override {
+        chip8_.timers();
+    }
+
+    void set_keys(const std::uint16_t mask) override {
+        for (int i = 0; i < 16; ++i) {
+            chip8_.set_key(static_cast<Input>(i), (mask >> i) & 1);
+        }
+    }
+
+   private:
+    std::string name_;
+    Hooks hooks_;
+    Chip8 chip8_;
+};
+
+}  // namespace
+
+std::unique_ptr<Engine> make_reference() {
+    return std::make_unique<HookedEngine<NoHooks>>("reference");
+}
+
+std::vector<std::unique_ptr<Engine>> make_candidates() {
+    std::vector<std::unique_ptr<Engine>> engines;
+    engines.push_back(std::make_unique<HookedEngine<Debugger>>("debugger"));
+    engines.push_back(std::make_unique<HookedEngine<Tracer>>("trace", "/dev/null"));
+    return engines;
+}
@@ -0,0 +1,40 @@
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "chip8.hpp"
+
+// A way of executing CHIP-8 code. Engines may keep the machine however they like
+// but have to be able to take and give back a Chip8 so they can be compared.
+class Engine {
+   public:
+    virtual ~Engine() = default;
+
+    [[nodiscard]] virtual std::string name() const = 0;
+
+    virtual void set_state(const Chip8 &chip8) = 0;
+
+    [[nodiscard]] virtual Chip8 state() const = 0;
+
+    [[nodiscard]] virtual std::uint64_t digest() const = 0;
+
+    // Whether the next step stays within RAM and is a known instruction
+    [[nodiscard]] virtual bool valid() const = 0;
+
+    virtual void step() = 0;
+
+    virtual void timers() = 0;
+
+    virtual void set_keys(const std::uint16_t mask) = 0;
+};
+
+// The plain Chip8::step() switch interpreter everything else is checked against
+[[nodiscard]] std::unique_ptr<Engine> make_reference();
+
+// Every other engine
+[[nodiscard]] std::vector<std::unique_ptr<Engine>> make_candidates();
+
+#endif
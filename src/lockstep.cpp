@@ -0,0 +1,275 @@
+#include "lockstep.hpp"
+#include "analysis.hpp"
+#include <cassert>
+#include <cstdio>
+#include <random>
+
+namespace lockstep {
+
+namespace {
+
+// Matches Application: 500hz CPU, timers every 16ms
+constexpr std::uint64_t steps_per_frame = 8;
+
+// Run an engine from instruction index `from` for up to n instructions, returns how many ran
+std::uint64_t advance(Engine &engine, const Keys &keys, const std::uint64_t from, const std::uint64_t n) {
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const std::uint64_t idx = from + i;
+
+        if (idx % steps_per_frame == 0) {
+            if (idx > 0) {
+                engine.timers();
+            }
+            engine.set_keys(keys(idx / steps_per_frame));
+        }
+
+        if (!engine.valid()) {
+            return i;
+        }
+        engine.step();
+    }
+    return n;
+}
+
+// Whether both engines agree after running n instructions from the checkpoint
+bool agree(Engine &reference,
+           Engine &candidate,
+           const Keys &keys,
+           const Chip8 &checkpoint,
+           const std::uint64_t from,
+           const std::uint64_t n) {
+    reference.set_state(checkpoint);
+    candidate.set_state(checkpoint);
+    const auto a = advance(reference, keys, from, n);
+    const auto b = advance(candidate, keys, from, n);
+    return a == b && reference.digest() == candidate.digest();
+}
+
+}  // namespace
+
+Result run(Engine &reference,
+           Engine &candidate,
+           const Chip8 &start,
+           const Keys &keys,
+           const std::uint64_t instructions,
+           const std::uint64_t interval) {
+    assert(interval > 0);
+
+    Result result;
+    Chip8 checkpoint = start;
+
+    reference.set_state(start);
+    candidate.set_state(start);
+
+    while (result.executed < instructions) {
+        const std::uint64_t n = std::min(interval, instructions - result.executed);
+        const auto a = advance(reference, keys, result.executed, n);
+        const auto b = advance(candidate, keys, result.executed, n);
+
+        if (a == b && reference.digest() == candidate.digest()) {
+            result.executed += a;
+            checkpoint = reference.state();
+            if (a < n) {
+                break;
+            }
+            continue;
+        }
+
+        // Agree after lo instructions, disagree after hi
+        std::uint64_t lo = 0;
+        std::uint64_t hi = std::max(a, b);
+        while (hi - lo > 1) {
+            const std::uint64_t mid = lo + (hi - lo) / 2;
+            if (agree(reference, candidate, keys, checkpoint, result.executed, mid)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+
+        Divergence divergence;
+        divergence.instruction = result.executed + lo;
+
+        reference.set_state(checkpoint);
+        advance(reference, keys, result.executed, lo);
+        divergence.before = reference.state();
+
+        agree(reference, candidate, keys, checkpoint, result.executed, lo + 1);
+        divergence.reference = reference.state();
+        divergence.candidate = candidate.state();
+
+        result.executed += lo;
+        result.divergence = divergence;
+        break;
+    }
+
+    return result;
+}
+
+std::string describe(const std::string &name, const Divergence &divergence) {
+    const auto &before = divergence.before;
+    const auto &a = divergence.reference;
+    const auto &b = divergence.candidate;
+    const std::uint16_t opcode = (before.ram()[before.pc()] << 8) + before.ram()[before.pc() + 1];
+
+    std::string out;
+    char line[128];
+    std::snprintf(line,
+                  sizeof(line),
+                  "%s diverges at instruction %llu\n",
+                  name.c_str(),
+                  static_cast<unsigned long long>(divergence.instruction));
+    out += line;
+    std::snprintf(line,
+                  sizeof(line),
+                  "  %03X  %04X  %s\n",
+                  before.pc(),
+                  opcode,
+                  analysis::disassemble(opcode).c_str());
+    out += line;
+    std::snprintf(line, sizeof(line), "  %-6s %10s %10s\n", "", "reference", name.c_str());
+    out += line;
+
+    const auto field = [&out, &line](const char *what, const int x, const int y) {
+        if (x != y) {
+            std::snprintf(line, sizeof(line), "  %-6s %10X %10X\n", what, x, y);
+            out += line;
+        }
+    };
+
+    field("PC", a.pc(), b.pc());
+    field("I", a.i(), b.i());
+    field("SP", a.sp(), b.sp());
+    field("DT", a.dt(), b.dt());
+    field("ST", a.st(), b.st());
+    for (int x = 0; x < 16; ++x) {
+        char what[8];
+        std::snprintf(what, sizeof(what), "V%X", x);
+        field(what, a.v(x), b.v(x));
+    }
+    for (int address = 0; address < 4096; ++address) {
+        char what[8];
+        std::snprintf(what, sizeof(what), "[%03X]", address);
+        field(what, a.ram()[address], b.ram()[address]);
+    }
+
+    return out;
+}
+
+std::vector<std::uint8_t> random_program(const std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    const auto random = [&rng](const int lo, const int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    };
+    // Code stays below the registers, stack and display at 0x6A0, which change under it
+    constexpr int code_end = 0x06A0;
+    // Even addresses in the program area
+    const auto target = [&random] {
+        return 0x200 + 2 * random(0, (code_end - 2 - 0x200) / 2);
+    };
+
+    std::vector<std::uint8_t> program;
+    program.reserve(code_end - 0x200);
+    // CALLs emitted so far without a matching RET, control flow is random so this only
+    // keeps RET on an empty stack rare rather than impossible
+    int depth = 0;
+
+    // Leave room for the jumps back to the start
+    while (program.size() < code_end - 0x200 - 4) {
+        const int x = random(0, 15);
+        const int y = random(0, 15);
+        const int kk = random(0, 255);
+        int opcode = 0;
+
+        switch (random(0, 33)) {
+            case 0:
+                opcode = 0x00E0;
+                break;
+            case 1:
+                if (depth > 0) {
+                    opcode = 0x00EE;
+                    depth--;
+                } else {
+                    opcode = 0x00E0;
+                }
+                break;
+            case 2:
+                opcode = 0x1000 | target();
+                break;
+            case 3:
+                opcode = 0x2000 | target();
+                depth++;
+                break;
+            case 4:
+                opcode = 0x3000 | (x << 8) | kk;
+                break;
+            case 5:
+                opcode = 0x4000 | (x << 8) | kk;
+                break;
+            case 6:
+                opcode = 0x5000 | (x << 8) | (y << 4);
+                break;
+            case 7:
+                opcode = 0x6000 | (x << 8) | kk;
+                break;
+            case 8:
+                opcode = 0x7000 | (x << 8) | kk;
+                break;
+            case 9:
+                opcode = 0x9000 | (x << 8) | (y << 4);
+                break;
+            case 10:
+                // Mostly the free RAM above the display, so Fx33 and Fx55 don't wreck the code.
+                // Low enough that a few Fx1E can't push I off the end.
+                opcode = 0xA000 | (random(0, 3) ? random(0x0800, 0x0EFF) : random(0x0000, 0x01FF));
+                break;
+            case 11:
+                // Room for V0 to be added without leaving the code
+                opcode = 0xB000 | (0x200 + 2 * random(0, (code_end - 0x100 - 0x200) / 2));
+                break;
+            case 12:
+                opcode = 0xC000 | (x << 8) | kk;
+                break;
+            case 13:
+                opcode = 0xD000 | (x << 8) | (y << 4) | random(0, 15);
+                break;
+            case 14:
+                opcode = 0xE09E | (x << 8);
+                break;
+            case 15:
+                opcode = 0xE0A1 | (x << 8);
+                break;
+            case 16:
+            case 17:
+            case 18:
+            case 19:
+            case 20:
+            case 21:
+            case 22:
+            case 23:
+            case 24: {
+                constexpr int alu[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xE};
+                opcode = 0x8000 | (x << 8) | (y << 4) | alu[random(0, 8)];
+                break;
+            }
+            default: {
+                constexpr int misc[] = {0x07, 0x0A, 0x15, 0x18, 0x1E, 0x29, 0x33, 0x55, 0x65};
+                opcode = 0xF000 | (x << 8) | misc[random(0, 8)];
+                break;
+            }
+        }
+
+        program.push_back(opcode >> 8);
+        program.push_back(opcode & 0xFF);
+    }
+
+    // Two so that a skip on the last instruction lands on one as well
+    for (int i = 0; i < 2; ++i) {
+        program.push_back(0x12);
+        program.push_back(0x00);
+    }
+
+    return program;
+}
+
+}  // namespace lockstep
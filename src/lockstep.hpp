@@ -0,0 +1,50 @@
+#ifndef LOCKSTEP_HPP
+#define LOCKSTEP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+#include "chip8.hpp"
+#include "engine.hpp"
+
+namespace lockstep {
+
+// Key mask to hold down during a given frame
+using Keys = std::function<std::uint16_t(std::uint64_t frame)>;
+
+struct Divergence {
+    // Index of the first instruction the engines disagree after
+    std::uint64_t instruction = 0;
+    // Reference state before that instruction
+    Chip8 before;
+    // States after it
+    Chip8 reference;
+    Chip8 candidate;
+};
+
+struct Result {
+    std::uint64_t executed = 0;
+    std::optional<Divergence> divergence;
+};
+
+// Run both engines side by side from start, comparing digests every interval
+// instructions and narrowing any mismatch down to a single instruction.
+// Stops early once the reference would step outside RAM.
+[[nodiscard]] Result run(Engine &reference,
+                         Engine &candidate,
+                         const Chip8 &start,
+                         const Keys &keys,
+                         const std::uint64_t instructions,
+                         const std::uint64_t interval);
+
+// Report of where and how the candidate went wrong, registers and RAM that differ are listed
+[[nodiscard]] std::string describe(const std::string &name, const Divergence &divergence);
+
+// A ROM filled with random but well formed instructions, with jumps kept in range
+[[nodiscard]] std::vector<std::uint8_t> random_program(const std::uint32_t seed);
+
+}  // namespace lockstep
+
+#endif
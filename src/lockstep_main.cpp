@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "engine.hpp"
+#include "lockstep.hpp"
+
+namespace {
+
+// Pseudo random key presses, roughly one key in eight held each frame
+lockstep::Keys random_keys(const std::uint64_t seed) {
+    return [seed](const std::uint64_t frame) {
+        std::uint64_t z = seed + frame * 0x9E3779B97F4A7C15;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        z ^= z >> 31;
+        return static_cast<std::uint16_t>(z & (z >> 16) & (z >> 32));
+    };
+}
+
+// Returns the number of divergences found, executed is how far the program got before
+// stopping or diverging, whichever candidate was shortest
+int check(const Chip8 &start,
+          const lockstep::Keys &keys,
+          const std::uint64_t instructions,
+          const std::uint64_t interval,
+          std::uint64_t &executed) {
+    int failures = 0;
+    const auto reference = make_reference();
+    executed = instructions;
+
+    for (const auto &candidate : make_candidates()) {
+        const auto result = lockstep::run(*reference, *candidate, start, keys, instructions, interval);
+        if (result.divergence) {
+            std::cout << lockstep::describe(candidate->name(), *result.divergence);
+            failures++;
+        }
+        executed = std::min(executed, result.executed);
+    }
+
+    return failures;
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    const char *rom = nullptr;
+    std::uint64_t instructions = 1000000;
+    std::uint64_t interval = 1000;
+    std::uint32_t seed = 1;
+    int fuzz = 0;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--instructions") == 0 && i + 1 < argc) {
+                instructions = std::stoull(argv[i + 1]);
+                i++;
+            } else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+                interval = std::max(1ull, std::stoull(argv[i + 1]));
+                i++;
+            } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = std::stoul(argv[i + 1]);
+                i++;
+            } else if (std::strcmp(argv[i], "--fuzz") == 0 && i + 1 < argc) {
+                fuzz = std::stoi(argv[i + 1]);
+                i++;
+            } else if (!rom) {
+                rom = argv[i];
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+    } catch (const std::exception &) {
+        rom = nullptr;
+        fuzz = 0;
+    }
+
+    if (!rom && fuzz <= 0) {
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  lockstep <rom> [--instructions <n>] [--interval <n>] [--seed <n>]" << std::endl;
+        std::cout << "  lockstep --fuzz <programs> [--instructions <n>] [--interval <n>] [--seed <n>]" << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+
+    if (rom) {
+        Chip8 chip8;
+        if (!chip8.load(rom)) {
+            std::cerr << "Failed to load ROM " << rom << std::endl;
+            return 2;
+        }
+        chip8.seed(seed);
+
+        std::uint64_t executed = 0;
+        failures += check(chip8, random_keys(seed), instructions, interval, executed);
+        std::cout << rom << " ran " << executed << " instructions" << std::endl;
+    }
+
+    // Programs that stop early check less than asked for, so say how far each got
+    std::uint64_t total = 0;
+    int short_runs = 0;
+
+    for (int i = 0; i < fuzz; ++i) {
+        const std::uint32_t program_seed = seed + i;
+        Chip8 chip8;
+        chip8.load(lockstep::random_program(program_seed));
+        chip8.seed(program_seed);
+
+        std::uint64_t executed = 0;
+        const int found = check(chip8, random_keys(program_seed), instructions, interval, executed);
+        if (found) {
+            std::cout << "  (fuzz seed " << program_seed << ")" << std::endl;
+        }
+        failures += found;
+
+        std::cout << "fuzz seed " << program_seed << " ran " << executed << " instructions" << std::endl;
+        total += executed;
+        short_runs += executed < instructions;
+    }
+
+    if (fuzz > 0) {
+        std::cout << fuzz << " programs ran " << total / fuzz << " instructions on average, " << short_runs
+                  << " stopped before " << instructions << std::endl;
+    }
+
+    if (failures == 0) {
+        std::cout << "All engines agree" << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -1,4 +1,7 @@
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include "application.hpp"
 
 int main(const int argc, const char **argv) {
@@ -15,9 +18,58 @@ int main(const int argc, const char **argv) {
     try {
         Application app("Chip8", 1024, 512);
 
-        // Load ROM
-        const auto r = app.load_rom(argv[1]);
-        if (!r) {
+        const char *name = nullptr;
+
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+                name = argv[i + 1];
+                i++;
+            } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+                app.trace(argv[i + 1]);
+                i++;
+            } else if (std::strcmp(argv[i], "--break") == 0 && i + 1 < argc) {
+                if (!app.debugger().add_breakpoint(std::string(argv[i + 1]))) {
+                    std::cerr << "Invalid breakpoint " << argv[i + 1] << std::endl;
+                    return 1;
+                }
+                options::debug = true;
+                i++;
+            } else if (std::strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+                if (!app.debugger().add_watchpoint(argv[i + 1])) {
+                    std::cerr << "Invalid watchpoint " << argv[i + 1] << std::endl;
+                    return 1;
+                }
+                options::debug = true;
+                i++;
+            } else if (std::strcmp(argv[i], "--cond") == 0 && i + 1 < argc) {
+                if (!app.debugger().add_condition(argv[i + 1])) {
+                    std::cerr << "Invalid condition " << argv[i + 1] << std::endl;
+                    return 1;
+                }
+                options::debug = true;
+                i++;
+            } else {
+                std::cerr << "Unknown argument " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+
+        // Load ROM, either a single file or by name from a pack
+        if (Pack::is_pack(argv[1]) && !name) {
+            const Pack pack(argv[1]);
+            std::cerr << argv[1] << " is a ROM pack, pick one with --name:" << std::endl;
+            for (std::size_t i = 0; i < pack.size(); ++i) {
+                std::cerr << "  " << pack[i].name << std::endl;
+            }
+            return 1;
+        } else if (name) {
+            const Pack pack(argv[1]);
+            const auto *entry = pack.find(name);
+            if (!entry || !app.load_rom(*entry)) {
+                std::cerr << "Failed to load ROM " << name << " from " << argv[1] << std::endl;
+                return 2;
+            }
+        } else if (!app.load_rom(argv[1])) {
             std::cerr << "Failed to load ROM " << argv[1] << std::endl;
             return 2;
         }
@@ -27,6 +79,9 @@ int main(const int argc, const char **argv) {
         }
     } catch (const std::bad_alloc &ex) {
         std::cerr << ex.what() << std::endl;
+    } catch (const std::runtime_error &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 2;
     }
 
     SDL_Quit();
@@ -0,0 +1,121 @@
+#include "pack.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr char magic[4] = {'C', '8', 'P', 'K'};
+
+std::uint16_t get_u16(const std::uint8_t *data) {
+    return data[0] | (data[1] << 8);
+}
+
+std::uint32_t get_u32(const std::uint8_t *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+}  // namespace
+
+Pack::Pack(const char *path) {
+    assert(path);
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Failed to open pack ") + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < pack::header_size) {
+        close(fd);
+        throw std::runtime_error(std::string("Not a pack file ") + path);
+    }
+    size_ = info.st_size;
+
+    void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error(std::string("Failed to map pack ") + path);
+    }
+    data_ = static_cast<const std::uint8_t *>(mapping);
+
+    const auto fail = [this, path](const char *why) {
+        munmap(const_cast<std::uint8_t *>(data_), size_);
+        throw std::runtime_error(std::string(why) + " " + path);
+    };
+
+    if (std::memcmp(data_, magic, 4) != 0) {
+        fail("Not a pack file");
+    }
+    if (get_u32(data_ + 4) != pack::version) {
+        fail("Unsupported pack version");
+    }
+
+    const std::uint64_t count = get_u32(data_ + 8);
+    if (pack::header_size + count * pack::entry_size > size_) {
+        fail("Truncated pack index");
+    }
+
+    entries_.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        const std::uint8_t *entry = data_ + pack::header_size + i * pack::entry_size;
+        const std::uint64_t rom_offset = get_u32(entry + 40);
+        const std::uint64_t rom_size = get_u32(entry + 44);
+        const std::uint64_t meta_offset = get_u32(entry + 48);
+        const std::uint64_t meta_size = get_u32(entry + 52);
+
+        if (rom_offset + rom_size > size_ || rom_size > 4096 - 0x200 || meta_offset + meta_size > size_ ||
+            meta_size < pack::meta_size) {
+            fail("Corrupt pack entry in");
+        }
+
+        const char *name = reinterpret_cast<const char *>(entry);
+        pack::Entry e;
+        e.name = std::string_view(name, strnlen(name, pack::name_size));
+        e.rom = std::span<const std::uint8_t>(data_ + rom_offset, rom_size);
+        e.code_map = std::span<const std::uint8_t>(data_ + meta_offset, pack::map_size);
+        e.write_map = std::span<const std::uint8_t>(data_ + meta_offset + pack::map_size, pack::map_size);
+        e.flags = data_[meta_offset + 2 * pack::map_size];
+        e.clock = get_u16(entry + 56);
+        e.quirks = entry[58];
+        names_.emplace(e.name, entries_.size());
+        entries_.push_back(e);
+    }
+}
+
+Pack::~Pack() {
+    munmap(const_cast<std::uint8_t *>(data_), size_);
+}
+
+bool Pack::is_pack(const char *path) {
+    assert(path);
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char buffer[4] = {};
+    const bool r = fread(buffer, sizeof(buffer), 1, file) == 1 && std::memcmp(buffer, magic, 4) == 0;
+    fclose(file);
+    return r;
+}
+
+std::size_t Pack::size() const {
+    return entries_.size();
+}
+
+const pack::Entry &Pack::operator[](const std::size_t idx) const {
+    assert(idx < entries_.size());
+    return entries_[idx];
+}
+
+const pack::Entry *Pack::find(const std::string_view name) const {
+    const auto iter = names_.find(name);
+    return iter == names_.end() ? nullptr : &entries_[iter->second];
+}
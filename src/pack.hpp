@@ -0,0 +1,89 @@
+#ifndef PACK_HPP
+#define PACK_HPP
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// File layout, all values little endian
+//   Header
+//     "C8PK", u32 version, u32 count, u32 reserved
+//   Index, count entries of 64 bytes
+//     char name[40] (NUL padded)
+//     u32 ROM offset, u32 ROM size
+//     u32 metadata offset, u32 metadata size
+//     u16 clock (hz), u8 quirks, u8 reserved[5]
+//   Metadata
+//     512 byte bitmap of reachable code, bit n = address n
+//     512 byte bitmap of addresses that may be written, see analysis::Result::writes
+//     u8 flags
+//   ROM bytes
+namespace pack {
+
+// 2 added the write map and flags to the metadata
+constexpr std::uint32_t version = 2;
+constexpr int header_size = 16;
+constexpr int entry_size = 64;
+constexpr int name_size = 40;
+constexpr int map_size = 4096 / 8;
+constexpr int meta_size = 2 * map_size + 1;
+// Metadata flags
+constexpr std::uint8_t self_modifying = 1 << 0;
+// Matches Application
+constexpr std::uint16_t default_clock = 500;
+
+struct Entry {
+    std::string_view name;
+    std::span<const std::uint8_t> rom;
+    std::span<const std::uint8_t> code_map;
+    std::span<const std::uint8_t> write_map;
+    std::uint8_t flags = 0;
+    std::uint16_t clock = default_clock;
+    std::uint8_t quirks = 0;
+
+    [[nodiscard]] bool is_code(const int address) const {
+        return (code_map[address / 8] >> (address % 8)) & 1;
+    }
+
+    [[nodiscard]] bool is_written(const int address) const {
+        return (write_map[address / 8] >> (address % 8)) & 1;
+    }
+
+    // Code that's never written doesn't need self-modification checks
+    [[nodiscard]] bool self_modifying() const {
+        return flags & pack::self_modifying;
+    }
+};
+
+}  // namespace pack
+
+// A memory-mapped ROM pack, entries point straight into the mapping
+class Pack {
+   public:
+    [[nodiscard]] explicit Pack(const char *path);
+
+    ~Pack();
+
+    Pack(const Pack &) = delete;
+
+    Pack &operator=(const Pack &) = delete;
+
+    [[nodiscard]] static bool is_pack(const char *path);
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] const pack::Entry &operator[](const std::size_t idx) const;
+
+    // nullptr if there's no ROM with that name
+    [[nodiscard]] const pack::Entry *find(const std::string_view name) const;
+
+   private:
+    const std::uint8_t *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<pack::Entry> entries_;
+    std::unordered_map<std::string_view, std::size_t> names_;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "analysis.hpp"
+#include "chip8.hpp"
+#include "pack.hpp"
+
+namespace {
+
+struct Rom {
+    std::string name;
+    std::vector<std::uint8_t> data;
+    std::uint16_t clock;
+};
+
+void put_u16(std::vector<std::uint8_t> &buffer, const std::size_t pos, const std::uint16_t n) {
+    buffer[pos + 0] = n & 0xFF;
+    buffer[pos + 1] = (n >> 8) & 0xFF;
+}
+
+void put_u32(std::vector<std::uint8_t> &buffer, const std::size_t pos, const std::uint32_t n) {
+    buffer[pos + 0] = n & 0xFF;
+    buffer[pos + 1] = (n >> 8) & 0xFF;
+    buffer[pos + 2] = (n >> 16) & 0xFF;
+    buffer[pos + 3] = (n >> 24) & 0xFF;
+}
+
+// Whole numbers of instructions per second that fit an entry's u16
+bool parse_clock(const char *text, std::uint16_t &clock) {
+    try {
+        std::size_t used = 0;
+        const int hz = std::stoi(text, &used);
+        if (used != std::strlen(text) || hz < 1 || hz > 0xFFFF) {
+            return false;
+        }
+        clock = hz;
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+int usage() {
+    std::cout << "Usage: pack <output> [--clock <hz>] <rom>..." << std::endl;
+    std::cout << "  <hz> is 1 to 65535, each --clock applies to the ROMs after it" << std::endl;
+    return 1;
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    if (argc < 3) {
+        return usage();
+    }
+
+    std::vector<Rom> roms;
+    std::set<std::string> names;
+    std::uint16_t clock = pack::default_clock;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--clock") == 0) {
+            if (i + 1 >= argc || !parse_clock(argv[i + 1], clock)) {
+                return usage();
+            }
+            i++;
+            continue;
+        }
+
+        Rom rom;
+        rom.name = std::filesystem::path(argv[i]).filename().string();
+        rom.clock = clock;
+
+        if (rom.name.size() >= pack::name_size) {
+            std::cerr << "ROM name too long " << rom.name << std::endl;
+            return 1;
+        }
+        if (!names.insert(rom.name).second) {
+            std::cerr << "Duplicate ROM name " << rom.name << std::endl;
+            return 1;
+        }
+        if (!read_rom(argv[i], rom.data)) {
+            std::cerr << "Failed to load ROM " << argv[i] << std::endl;
+            return 2;
+        }
+
+        roms.push_back(std::move(rom));
+    }
+
+    // Header and index first, then each ROM's metadata followed by its bytes
+    std::vector<std::uint8_t> buffer(pack::header_size + roms.size() * pack::entry_size);
+    std::memcpy(buffer.data(), "C8PK", 4);
+    put_u32(buffer, 4, pack::version);
+    put_u32(buffer, 8, roms.size());
+
+    for (std::size_t i = 0; i < roms.size(); ++i) {
+        const auto &rom = roms[i];
+        const std::size_t entry = pack::header_size + i * pack::entry_size;
+
+        const auto result = analysis::analyze(rom.data);
+        const std::size_t meta_offset = buffer.size();
+        buffer.resize(buffer.size() + pack::meta_size);
+        for (int a = 0; a < 4096; ++a) {
+            if (result.code.test(a)) {
+                buffer[meta_offset + a / 8] |= 1 << (a % 8);
+            }
+            if (result.writes.test(a)) {
+                buffer[meta_offset + pack::map_size + a / 8] |= 1 << (a % 8);
+            }
+        }
+        if (result.self_modifying()) {
+            buffer[meta_offset + 2 * pack::map_size] |= pack::self_modifying;
+        }
+
+        const std::size_t rom_offset = buffer.size();
+        buffer.insert(buffer.end(), rom.data.begin(), rom.data.end());
+
+        std::memcpy(&buffer[entry], rom.name.data(), rom.name.size());
+        put_u32(buffer, entry + 40, rom_offset);
+        put_u32(buffer, entry + 44, rom.data.size());
+        put_u32(buffer, entry + 48, meta_offset);
+        put_u32(buffer, entry + 52, pack::meta_size);
+        put_u16(buffer, entry + 56, rom.clock);
+        buffer[entry + 58] = 0;
+    }
+
+    FILE *file = fopen(argv[1], "wb");
+    if (!file) {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return 2;
+    }
+    const bool ok = fwrite(buffer.data(), buffer.size(), 1, file) == 1;
+    if (fclose(file) != 0 || !ok) {
+        std::cerr << "Failed to write " << argv[1] << std::endl;
+        return 2;
+    }
+
+    std::cout << "Packed " << roms.size() << " ROMs into " << argv[1] << std::endl;
+
+    return 0;
+}
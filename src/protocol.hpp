@@ -0,0 +1,48 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstdint>
+
+// Every message is framed as
+//   u8  type
+//   u16 payload length (little endian)
+//   ... payload
+//
+// Client -> Server
+//   Create   ROM bytes
+//   Keys     u32 session, u16 key mask (bit n = Input n)
+//   Destroy  u32 session
+//   Open     ROM name in the server's pack
+//
+// Server -> Client
+//   Created  u32 session
+//   Frame    u32 session, then runs of {u8 offset, u8 length, bytes} patching the 256 byte display
+//   Error    u8 error code
+namespace protocol {
+
+enum class Message : std::uint8_t
+{
+    Create = 0x01,
+    Keys = 0x02,
+    Destroy = 0x03,
+    Open = 0x04,
+    Created = 0x81,
+    Frame = 0x82,
+    Error = 0x83,
+};
+
+enum class Error : std::uint8_t
+{
+    BadMessage = 0x01,
+    BadRom = 0x02,
+    NoSession = 0x03,
+    // Over the server wide or per client limit
+    TooManySessions = 0x04,
+};
+
+constexpr int header_size = 3;
+constexpr int max_payload = 0xFFFF;
+
+}  // namespace protocol
+
+#endif
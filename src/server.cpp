@@ -0,0 +1,338 @@
+#include "server.hpp"
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+using clockz = std::chrono::steady_clock;
+
+namespace {
+
+// Matches Application: 60hz frames
+constexpr auto frame_time = std::chrono::milliseconds(16);
+constexpr std::size_t max_sessions = 4096;
+// So one client can't take every session
+constexpr int max_client_sessions = 64;
+// Clients that stop reading get dropped rather than buffered forever
+constexpr std::size_t max_backlog = 1 << 20;
+
+std::uint16_t get_u16(const std::uint8_t *data) {
+    return data[0] | (data[1] << 8);
+}
+
+std::uint32_t get_u32(const std::uint8_t *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+void put_header(std::vector<std::uint8_t> &buffer, const protocol::Message type, const std::uint16_t length) {
+    buffer.push_back(static_cast<std::uint8_t>(type));
+    buffer.push_back(length & 0xFF);
+    buffer.push_back((length >> 8) & 0xFF);
+}
+
+void put_u32(std::vector<std::uint8_t> &buffer, const std::uint32_t n) {
+    buffer.push_back(n & 0xFF);
+    buffer.push_back((n >> 8) & 0xFF);
+    buffer.push_back((n >> 16) & 0xFF);
+    buffer.push_back((n >> 24) & 0xFF);
+}
+
+void set_nonblocking(const int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+}  // namespace
+
+Server::Server(const char *path, const std::size_t threads, const Pack *pack)
+    : path_(path), pool_(threads), pack_(pack) {
+    assert(path);
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path_.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path too long");
+    }
+    std::strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error(std::string("socket() error: ") + std::strerror(errno));
+    }
+
+    // Remove any stale socket left behind by a previous run
+    unlink(path_.c_str());
+
+    if (bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listen_fd_, 64) != 0) {
+        const std::string error = std::strerror(errno);
+        close(listen_fd_);
+        throw std::runtime_error("bind() error: " + error);
+    }
+
+    set_nonblocking(listen_fd_);
+}
+
+Server::~Server() {
+    for (const auto &[fd, client] : clients_) {
+        close(fd);
+    }
+    close(listen_fd_);
+    unlink(path_.c_str());
+}
+
+void Server::stop() {
+    quit_ = true;
+}
+
+void Server::run() {
+    auto next_frame = clockz::now() + frame_time;
+    std::vector<pollfd> fds;
+
+    while (!quit_) {
+        fds.clear();
+        fds.push_back({listen_fd_, POLLIN, 0});
+        for (const auto &[fd, client] : clients_) {
+            const short events = POLLIN | (client.out.empty() ? 0 : POLLOUT);
+            fds.push_back({fd, events, 0});
+        }
+
+        const auto now = clockz::now();
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next_frame - now);
+        const int r = poll(fds.data(), fds.size(), std::max(0, static_cast<int>(wait.count())));
+        if (r < 0 && errno != EINTR) {
+            throw std::runtime_error(std::string("poll() error: ") + std::strerror(errno));
+        }
+
+        if (r > 0) {
+            if (fds[0].revents & POLLIN) {
+                accept_clients();
+            }
+
+            for (std::size_t i = 1; i < fds.size(); ++i) {
+                const auto iter = clients_.find(fds[i].fd);
+                if (iter == clients_.end()) {
+                    continue;
+                }
+
+                auto &client = iter->second;
+                if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    read_client(fds[i].fd, client);
+                }
+                // Closing clients get one last try at flushing replies, e.g. after a half-close
+                if (!client.out.empty() && (client.closing || fds[i].revents & POLLOUT)) {
+                    write_client(fds[i].fd, client);
+                }
+                if (client.closing) {
+                    disconnect(fds[i].fd);
+                }
+            }
+        }
+
+        if (next_frame <= clockz::now()) {
+            frame();
+            next_frame += frame_time;
+
+            // Don't try to catch up if we've fallen far behind
+            if (next_frame + 4 * frame_time < clockz::now()) {
+                next_frame = clockz::now() + frame_time;
+            }
+        }
+    }
+}
+
+void Server::accept_clients() {
+    while (true) {
+        const int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            break;
+        }
+        set_nonblocking(fd);
+        clients_[fd] = Client();
+    }
+}
+
+void Server::read_client(const int fd, Client &client) {
+    std::uint8_t buffer[4096];
+
+    while (true) {
+        const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            client.in.insert(client.in.end(), buffer, buffer + n);
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            // Still handle whatever arrived before the peer closed or shut down writing
+            client.closing = true;
+            break;
+        }
+    }
+
+    // Handle every complete message
+    std::size_t pos = 0;
+    while (client.in.size() - pos >= protocol::header_size) {
+        const auto type = static_cast<protocol::Message>(client.in[pos]);
+        const int length = get_u16(&client.in[pos + 1]);
+        if (client.in.size() - pos < protocol::header_size + static_cast<std::size_t>(length)) {
+            break;
+        }
+        handle(fd, client, type, &client.in[pos + protocol::header_size], length);
+        pos += protocol::header_size + length;
+    }
+    client.in.erase(client.in.begin(), client.in.begin() + pos);
+}
+
+void Server::write_client(const int fd, Client &client) {
+    std::size_t pos = 0;
+
+    while (pos < client.out.size()) {
+        const ssize_t n = send(fd, client.out.data() + pos, client.out.size() - pos, MSG_NOSIGNAL);
+        if (n > 0) {
+            pos += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            client.closing = true;
+            break;
+        }
+    }
+
+    client.out.erase(client.out.begin(), client.out.begin() + pos);
+}
+
+void Server::handle(const int fd,
+                    Client &client,
+                    const protocol::Message type,
+                    const std::uint8_t *data,
+                    const int size) {
+    switch (type) {
+        case protocol::Message::Create: {
+            pack::Entry entry;
+            entry.rom = std::span<const std::uint8_t>(data, size);
+            create(fd, client, entry);
+            break;
+        }
+        case protocol::Message::Open: {
+            const auto name = std::string_view(reinterpret_cast<const char *>(data), size);
+            const auto *entry = pack_ ? pack_->find(name) : nullptr;
+            if (!entry) {
+                send_error(client, protocol::Error::BadRom);
+                break;
+            }
+            create(fd, client, *entry);
+            break;
+        }
+        case protocol::Message::Keys: {
+            if (size != 6) {
+                send_error(client, protocol::Error::BadMessage);
+                break;
+            }
+
+            const auto iter = sessions_.find(get_u32(data));
+            if (iter == sessions_.end() || iter->second->owner() != fd) {
+                send_error(client, protocol::Error::NoSession);
+                break;
+            }
+
+            iter->second->set_keys(get_u16(data + 4));
+            break;
+        }
+        case protocol::Message::Destroy: {
+            if (size != 4) {
+                send_error(client, protocol::Error::BadMessage);
+                break;
+            }
+
+            const auto iter = sessions_.find(get_u32(data));
+            if (iter == sessions_.end() || iter->second->owner() != fd) {
+                send_error(client, protocol::Error::NoSession);
+                break;
+            }
+
+            std::erase(active_, iter->second.get());
+            sessions_.erase(iter);
+            client.sessions--;
+            break;
+        }
+        default:
+            send_error(client, protocol::Error::BadMessage);
+            break;
+    }
+}
+
+void Server::create(const int fd, Client &client, const pack::Entry &entry) {
+    if (sessions_.size() >= max_sessions || client.sessions >= max_client_sessions) {
+        send_error(client, protocol::Error::TooManySessions);
+        return;
+    }
+
+    auto session = std::make_unique<Session>(next_id_, fd);
+    if (entry.clock == 0 || !session->load(entry.rom)) {
+        send_error(client, protocol::Error::BadRom);
+        return;
+    }
+    session->set_clock(entry.clock);
+
+    put_header(client.out, protocol::Message::Created, 4);
+    put_u32(client.out, next_id_);
+
+    active_.push_back(session.get());
+    sessions_[next_id_] = std::move(session);
+    next_id_++;
+    client.sessions++;
+}
+
+void Server::send_error(Client &client, const protocol::Error error) {
+    put_header(client.out, protocol::Message::Error, 1);
+    client.out.push_back(static_cast<std::uint8_t>(error));
+}
+
+void Server::frame() {
+    // Step every session on the pool
+    pool_.run(active_.size(), [this](const std::size_t idx) {
+        active_[idx]->frame();
+    });
+
+    // Queue up the display changes
+    for (auto *session : active_) {
+        auto &delta = session->delta();
+        if (delta.empty()) {
+            continue;
+        }
+
+        auto &client = clients_.at(session->owner());
+        client.out.insert(client.out.end(), delta.begin(), delta.end());
+        delta.clear();
+    }
+
+    std::vector<int> dropped;
+    for (const auto &[fd, client] : clients_) {
+        if (client.out.size() > max_backlog) {
+            dropped.push_back(fd);
+        }
+    }
+    for (const int fd : dropped) {
+        disconnect(fd);
+    }
+}
+
+void Server::disconnect(const int fd) {
+    std::erase_if(active_, [fd](const Session *session) {
+        return session->owner() == fd;
+    });
+    std::erase_if(sessions_, [fd](const auto &pair) {
+        return pair.second->owner() == fd;
+    });
+    clients_.erase(fd);
+    close(fd);
+}
@@ -0,0 +1,66 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pack.hpp"
+#include "protocol.hpp"
+#include "session.hpp"
+#include "thread_pool.hpp"
+
+class Server {
+   public:
+    // Sessions can also be opened by name from pack, which may be nullptr
+    [[nodiscard]] Server(const char *path, const std::size_t threads, const Pack *pack);
+
+    ~Server();
+
+    Server(const Server &) = delete;
+
+    Server &operator=(const Server &) = delete;
+
+    // Serve clients until stop() is called
+    void run();
+
+    void stop();
+
+   private:
+    struct Client {
+        std::vector<std::uint8_t> in;
+        std::vector<std::uint8_t> out;
+        int sessions = 0;
+        bool closing = false;
+    };
+
+    void accept_clients();
+
+    void read_client(const int fd, Client &client);
+
+    void write_client(const int fd, Client &client);
+
+    void handle(const int fd, Client &client, const protocol::Message type, const std::uint8_t *data, const int size);
+
+    void create(const int fd, Client &client, const pack::Entry &entry);
+
+    void send_error(Client &client, const protocol::Error error);
+
+    void frame();
+
+    void disconnect(const int fd);
+
+    std::string path_;
+    int listen_fd_ = -1;
+    ThreadPool pool_;
+    const Pack *pack_;
+    std::map<int, Client> clients_;
+    std::map<std::uint32_t, std::unique_ptr<Session>> sessions_;
+    std::vector<Session *> active_;
+    std::uint32_t next_id_ = 1;
+    std::atomic<bool> quit_ = false;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "server.hpp"
+
+namespace {
+
+// More than this is a typo rather than a machine
+constexpr unsigned long max_threads = 1024;
+
+Server *server = nullptr;
+
+void on_signal(int) {
+    if (server) {
+        server->stop();
+    }
+}
+
+bool parse_threads(const char *text, std::size_t &threads) {
+    try {
+        // stoul would quietly turn "-1" into ULONG_MAX
+        if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+            return false;
+        }
+        std::size_t used = 0;
+        const unsigned long n = std::stoul(text, &used);
+        if (used != std::strlen(text) || n > max_threads) {
+            return false;
+        }
+        threads = n;
+        return true;
+    } catch (const std::exception &) {
+        return false;
+    }
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    if (argc < 2) {
+        std::cout << "No path to socket specified" << std::endl;
+        return 1;
+    }
+
+    // Leave one core for the thread handling the socket
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    const char *pack_path = nullptr;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) {
+            pack_path = argv[i + 1];
+            i++;
+            continue;
+        }
+
+        if (!parse_threads(argv[i], threads)) {
+            std::cerr << "Invalid thread count " << argv[i] << ", expected 0 to " << max_threads << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        std::unique_ptr<Pack> pack;
+        if (pack_path) {
+            pack = std::make_unique<Pack>(pack_path);
+        }
+
+        Server s(argv[1], threads, pack.get());
+
+        server = &s;
+        std::signal(SIGINT, on_signal);
+        std::signal(SIGTERM, on_signal);
+
+        s.run();
+
+        server = nullptr;
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
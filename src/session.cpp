@@ -0,0 +1,112 @@
+#include "session.hpp"
+#include <cassert>
+#include "protocol.hpp"
+
+namespace {
+
+// Matches Application: 16ms frames
+constexpr int frame_ms = 16;
+
+void put_u32(std::vector<std::uint8_t> &buffer, const std::uint32_t n) {
+    buffer.push_back(n & 0xFF);
+    buffer.push_back((n >> 8) & 0xFF);
+    buffer.push_back((n >> 16) & 0xFF);
+    buffer.push_back((n >> 24) & 0xFF);
+}
+
+}  // namespace
+
+Session::Session(const std::uint32_t id, const int owner) : id_(id), owner_(owner) {
+}
+
+bool Session::load(const std::span<const std::uint8_t> rom) {
+    return chip8_.load(rom);
+}
+
+void Session::set_keys(const std::uint16_t mask) {
+    for (int i = 0; i < 16; ++i) {
+        chip8_.set_key(static_cast<Input>(i), (mask >> i) & 1);
+    }
+}
+
+void Session::set_clock(const int hz) {
+    assert(hz > 0);
+    clock_ = hz;
+}
+
+void Session::frame() {
+    // Carry over fractional steps so the average rate matches the clock
+    budget_ += clock_ * frame_ms;
+    const int steps = budget_ / 1000;
+    budget_ %= 1000;
+
+    // A broken ROM just stops, it mustn't scribble outside its own machine or trip an assert
+    for (int i = 0; i < steps && chip8_.valid(); ++i) {
+        chip8_.step();
+    }
+    chip8_.timers();
+
+    encode();
+}
+
+std::uint32_t Session::id() const {
+    return id_;
+}
+
+int Session::owner() const {
+    return owner_;
+}
+
+std::vector<std::uint8_t> &Session::delta() {
+    return delta_;
+}
+
+void Session::encode() {
+    const auto display = chip8_.display();
+
+    delta_.clear();
+
+    int idx = 0;
+    while (idx < 256) {
+        // Find the start of the next changed run
+        if (display[idx] == last_[idx]) {
+            idx++;
+            continue;
+        }
+
+        // Extend it, swallowing gaps of unchanged bytes no bigger than a run header
+        int end = idx + 1;
+        int gap = 0;
+        for (int i = idx + 1; i < 256 && i - idx < 255; ++i) {
+            if (display[i] != last_[i]) {
+                end = i + 1;
+                gap = 0;
+            } else if (++gap > 2) {
+                break;
+            }
+        }
+
+        if (delta_.empty()) {
+            delta_.push_back(static_cast<std::uint8_t>(protocol::Message::Frame));
+            delta_.push_back(0);
+            delta_.push_back(0);
+            put_u32(delta_, id_);
+        }
+
+        delta_.push_back(idx);
+        delta_.push_back(end - idx);
+        for (int i = idx; i < end; ++i) {
+            delta_.push_back(display[i]);
+            last_[i] = display[i];
+        }
+
+        idx = end;
+    }
+
+    if (!delta_.empty()) {
+        const std::size_t length = delta_.size() - protocol::header_size;
+        assert(length <= protocol::max_payload);
+        delta_[1] = length & 0xFF;
+        delta_[2] = (length >> 8) & 0xFF;
+    }
+}
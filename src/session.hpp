@@ -0,0 +1,42 @@
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "chip8.hpp"
+
+class Session {
+   public:
+    [[nodiscard]] Session(const std::uint32_t id, const int owner);
+
+    bool load(const std::span<const std::uint8_t> rom);
+
+    void set_keys(const std::uint16_t mask);
+
+    void set_clock(const int hz);
+
+    // Run one 60hz frame worth of emulation and encode any display changes
+    void frame();
+
+    [[nodiscard]] std::uint32_t id() const;
+
+    [[nodiscard]] int owner() const;
+
+    // The encoded Frame message from the last call to frame(), empty if the display didn't change
+    [[nodiscard]] std::vector<std::uint8_t> &delta();
+
+   private:
+    void encode();
+
+    Chip8 chip8_;
+    std::array<std::uint8_t, 256> last_ = {};
+    std::vector<std::uint8_t> delta_;
+    int clock_ = 500;
+    int budget_ = 0;
+    std::uint32_t id_;
+    int owner_;
+};
+
+#endif
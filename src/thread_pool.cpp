@@ -0,0 +1,98 @@
+#include "thread_pool.hpp"
+#include <cassert>
+
+ThreadPool::ThreadPool(const std::size_t threads) {
+    try {
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back(&ThreadPool::work, this);
+        }
+    } catch (...) {
+        // The destructor won't run, and destroying joinable threads would terminate
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        wake_.notify_all();
+        for (auto &thread : threads_) {
+            thread.join();
+        }
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return threads_.size();
+}
+
+void ThreadPool::run(const std::size_t count, const std::function<void(std::size_t)> &func) {
+    if (count == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        assert(busy_ == 0);
+        func_ = &func;
+        count_ = count;
+        next_ = 0;
+        busy_ = threads_.size();
+        generation_++;
+    }
+    wake_.notify_all();
+
+    // The calling thread helps out rather than sitting idle
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] {
+        return busy_ == 0;
+    });
+    func_ = nullptr;
+}
+
+void ThreadPool::drain() {
+    while (true) {
+        const std::size_t idx = next_.fetch_add(1);
+        if (idx >= count_) {
+            break;
+        }
+        (*func_)(idx);
+    }
+}
+
+void ThreadPool::work() {
+    std::uint64_t seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen] {
+                return quit_ || generation_ != seen;
+            });
+            if (quit_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        drain();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_--;
+        }
+        done_.notify_one();
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+   public:
+    [[nodiscard]] explicit ThreadPool(const std::size_t threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Call func(0) .. func(count - 1) across the pool and wait for them all
+    void run(const std::size_t count, const std::function<void(std::size_t)> &func);
+
+    [[nodiscard]] std::size_t size() const;
+
+   private:
+    void work();
+
+    void drain();
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(std::size_t)> *func_ = nullptr;
+    std::size_t count_ = 0;
+    std::atomic<std::size_t> next_ = 0;
+    std::size_t busy_ = 0;
+    std::uint64_t generation_ = 0;
+    bool quit_ = false;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "trace.hpp"
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::size_t chunk_size = 1 << 20;
+constexpr char magic[4] = {'C', '8', 'T', 'R'};
+
+}  // namespace
+
+Tracer::Tracer(const char *path) {
+    assert(path);
+
+    file_ = fopen(path, "wb");
+    if (!file_) {
+        throw std::runtime_error(std::string("Failed to open trace file ") + path);
+    }
+
+    std::uint8_t header[8] = {};
+    std::memcpy(header, magic, 4);
+    header[4] = trace::version & 0xFF;
+    fwrite(header, sizeof(header), 1, file_);
+
+    for (auto &chunk : chunks_) {
+        chunk.data.resize(chunk_size);
+        free_.push_back(&chunk);
+    }
+
+    current_ = free_.front();
+    free_.pop_front();
+    cursor_ = current_->data.data();
+    limit_ = cursor_ + current_->data.size();
+
+    writer_ = std::thread(&Tracer::work, this);
+}
+
+Tracer::~Tracer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_->used = cursor_ - current_->data.data();
+        full_.push_back(current_);
+        quit_ = true;
+    }
+    cv_.notify_all();
+
+    writer_.join();
+    fclose(file_);
+}
+
+std::uint64_t Tracer::cycles() const {
+    return cycle_;
+}
+
+void Tracer::submit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    current_->used = cursor_ - current_->data.data();
+    full_.push_back(current_);
+    cv_.notify_all();
+
+    // Only blocks if the writer has fallen a whole pool of chunks behind
+    cv_.wait(lock, [this] {
+        return !free_.empty();
+    });
+    current_ = free_.front();
+    free_.pop_front();
+
+    cursor_ = current_->data.data();
+    limit_ = cursor_ + current_->data.size();
+}
+
+void Tracer::work() {
+    while (true) {
+        Chunk *chunk = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return quit_ || !full_.empty();
+            });
+            if (full_.empty()) {
+                return;
+            }
+            chunk = full_.front();
+            full_.pop_front();
+        }
+
+        fwrite(chunk->data.data(), 1, chunk->used, file_);
+        chunk->used = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(chunk);
+        }
+        cv_.notify_all();
+    }
+}
+
+TraceReader::TraceReader(const char *path) {
+    assert(path);
+
+    file_ = fopen(path, "rb");
+    if (!file_) {
+        throw std::runtime_error(std::string("Failed to open trace file ") + path);
+    }
+
+    std::uint8_t header[8] = {};
+    if (fread(header, sizeof(header), 1, file_) != 1 || std::memcmp(header, magic, 4) != 0 ||
+        header[4] != trace::version) {
+        fclose(file_);
+        throw std::runtime_error(std::string("Not a trace file ") + path);
+    }
+}
+
+TraceReader::~TraceReader() {
+    fclose(file_);
+}
+
+bool TraceReader::next(trace::Record &record) {
+    std::uint8_t header[10];
+    if (fread(header, sizeof(header), 1, file_) != 1) {
+        return false;
+    }
+
+    // The file only stores the low 32 bits of the cycle
+    const std::uint32_t low = header[0] | (header[1] << 8) | (header[2] << 16) | (header[3] << 24);
+    std::uint64_t cycle = (cycle_ & ~0xFFFFFFFFull) | low;
+    if (cycle < cycle_) {
+        cycle += 1ull << 32;
+    }
+    cycle_ = cycle;
+
+    record.cycle = cycle;
+    record.pc = header[4] | (header[5] << 8);
+    record.opcode = header[6] | (header[7] << 8);
+
+    const int count = header[8] | (header[9] << 8);
+    record.deltas.resize(count);
+    for (auto &delta : record.deltas) {
+        std::uint8_t data[4];
+        if (fread(data, sizeof(data), 1, file_) != 1) {
+            return false;
+        }
+        delta.address = data[0] | (data[1] << 8);
+        delta.value = data[2] | (data[3] << 8);
+    }
+
+    return true;
+}
@@ -0,0 +1,249 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "chip8.hpp"
+
+// File layout
+//   "C8TR", u32 version
+//   Records of
+//     u32 cycle (low bits, wraps), u16 pc, u16 opcode, u16 count
+//     count * {u16 address, u16 value}
+//
+// All values are little endian. Only bytes and registers that changed get a delta.
+// Register V deltas use their RAM address, the registers that don't live in RAM
+// use the pseudo addresses below.
+namespace trace {
+
+constexpr std::uint32_t version = 1;
+constexpr std::uint16_t reg_i = 0x1000;
+constexpr std::uint16_t reg_sp = 0x1001;
+constexpr std::uint16_t reg_dt = 0x1002;
+constexpr std::uint16_t reg_st = 0x1003;
+
+struct Delta {
+    std::uint16_t address = 0;
+    std::uint16_t value = 0;
+
+    bool operator==(const Delta &) const = default;
+};
+
+struct Record {
+    std::uint64_t cycle = 0;
+    std::uint16_t pc = 0;
+    std::uint16_t opcode = 0;
+    std::vector<Delta> deltas;
+};
+
+}  // namespace trace
+
+// Step hooks recording every instruction into pre-allocated chunks that a background thread writes out
+class Tracer {
+   public:
+    [[nodiscard]] explicit Tracer(const char *path);
+
+    ~Tracer();
+
+    Tracer(const Tracer &) = delete;
+
+    Tracer &operator=(const Tracer &) = delete;
+
+    void before(const Chip8 &chip8, const std::uint16_t opcode);
+
+    void write(const int address, const int length);
+
+    void after(const Chip8 &chip8);
+
+    [[nodiscard]] std::uint64_t cycles() const;
+
+   private:
+    struct Chunk {
+        std::vector<std::uint8_t> data;
+        std::size_t used = 0;
+    };
+
+    struct Range {
+        std::uint16_t address;
+        std::uint16_t length;
+        // Where its bytes from before the step start in old_
+        std::uint16_t offset;
+    };
+
+    void submit();
+
+    void work();
+
+    // Producer side, only touched by the stepping thread
+    Chunk *current_ = nullptr;
+    std::uint8_t *cursor_ = nullptr;
+    std::uint8_t *limit_ = nullptr;
+    std::uint64_t cycle_ = 0;
+    std::uint16_t pc_ = 0;
+    std::uint16_t opcode_ = 0;
+    std::array<std::uint8_t, 16> v_ = {};
+    std::uint16_t i_ = 0;
+    std::uint16_t sp_ = 0;
+    std::uint8_t dt_ = 0;
+    std::uint8_t st_ = 0;
+    const std::uint8_t *ram_ = nullptr;
+    std::array<Range, 32> ranges_ = {};
+    int num_ranges_ = 0;
+    // Written bytes as they were before the step, so only real changes get recorded
+    std::array<std::uint8_t, 512> old_ = {};
+    int old_used_ = 0;
+    // Shared with the writer thread
+    std::array<Chunk, 4> chunks_;
+    std::deque<Chunk *> free_;
+    std::deque<Chunk *> full_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool quit_ = false;
+    FILE *file_ = nullptr;
+    std::thread writer_;
+};
+
+// Sequential reader for trace files
+class TraceReader {
+   public:
+    [[nodiscard]] explicit TraceReader(const char *path);
+
+    ~TraceReader();
+
+    TraceReader(const TraceReader &) = delete;
+
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    bool next(trace::Record &record);
+
+   private:
+    FILE *file_ = nullptr;
+    std::uint64_t cycle_ = 0;
+};
+
+namespace trace {
+
+inline std::uint8_t *put_u16(std::uint8_t *out, const std::uint16_t n) {
+    out[0] = n & 0xFF;
+    out[1] = n >> 8;
+    return out + 2;
+}
+
+inline std::uint8_t *put_delta(std::uint8_t *out, const std::uint16_t address, const std::uint16_t value) {
+    return put_u16(put_u16(out, address), value);
+}
+
+}  // namespace trace
+
+inline void Tracer::before(const Chip8 &chip8, const std::uint16_t opcode) {
+    pc_ = chip8.pc();
+    opcode_ = opcode;
+    std::copy_n(&chip8.ram()[0x06A0], 16, v_.begin());
+    i_ = chip8.i();
+    sp_ = chip8.sp();
+    dt_ = chip8.dt();
+    st_ = chip8.st();
+    ram_ = chip8.ram().data();
+    num_ranges_ = 0;
+    old_used_ = 0;
+}
+
+inline void Tracer::write(const int address, const int length) {
+    if (num_ranges_ >= static_cast<int>(ranges_.size()) || old_used_ + length > static_cast<int>(old_.size())) {
+        return;
+    }
+
+    ranges_[num_ranges_] = {static_cast<std::uint16_t>(address),
+                            static_cast<std::uint16_t>(length),
+                            static_cast<std::uint16_t>(old_used_)};
+    num_ranges_++;
+
+    if (address + length <= 4096) {
+        std::memcpy(&old_[old_used_], ram_ + address, length);
+    } else {
+        for (int a = 0; a < length; ++a) {
+            old_[old_used_ + a] = ram_[(address + a) & 0xFFF];
+        }
+    }
+    old_used_ += length;
+}
+
+inline void Tracer::after(const Chip8 &chip8) {
+    // Worst case: 00E0 rewriting the display plus every register changing
+    constexpr int max_record = 10 + 4 * (256 + 16 + 4);
+    if (limit_ - cursor_ < max_record) {
+        submit();
+    }
+
+    // Work on a local cursor, byte stores through a member would force every other member to be reloaded
+    std::uint8_t *out = cursor_;
+    const std::uint32_t cycle = cycle_;
+    out = trace::put_u16(out, cycle & 0xFFFF);
+    out = trace::put_u16(out, cycle >> 16);
+    out = trace::put_u16(out, pc_);
+    out = trace::put_u16(out, opcode_);
+    std::uint8_t *const count = out;
+    out += 2;
+    std::uint8_t *const start = out;
+
+    const auto &ram = chip8.ram();
+    for (int x = 0; x < 16; ++x) {
+        if (ram[0x06A0 + x] != v_[x]) {
+            out = trace::put_delta(out, 0x06A0 + x, ram[0x06A0 + x]);
+        }
+    }
+    if (chip8.i() != i_) {
+        out = trace::put_delta(out, trace::reg_i, chip8.i());
+    }
+    if (chip8.sp() != sp_) {
+        out = trace::put_delta(out, trace::reg_sp, chip8.sp());
+    }
+    if (chip8.dt() != dt_) {
+        out = trace::put_delta(out, trace::reg_dt, chip8.dt());
+    }
+    if (chip8.st() != st_) {
+        out = trace::put_delta(out, trace::reg_st, chip8.st());
+    }
+    for (int r = 0; r < num_ranges_; ++r) {
+        const auto &range = ranges_[r];
+        const std::uint8_t *old = &old_[range.offset];
+        int a = 0;
+        // Skip unchanged words, 00E0 on a blank display shouldn't cost 256 deltas
+        if (range.address + range.length <= 4096) {
+            for (; a + 8 <= range.length; a += 8) {
+                std::uint64_t now;
+                std::uint64_t then;
+                std::memcpy(&now, &ram[range.address + a], 8);
+                std::memcpy(&then, old + a, 8);
+                if (now == then) {
+                    continue;
+                }
+                for (int b = a; b < a + 8; ++b) {
+                    if (ram[range.address + b] != old[b]) {
+                        out = trace::put_delta(out, range.address + b, ram[range.address + b]);
+                    }
+                }
+            }
+        }
+        for (; a < range.length; ++a) {
+            const int address = (range.address + a) & 0xFFF;
+            if (ram[address] != old[a]) {
+                out = trace::put_delta(out, address, ram[address]);
+            }
+        }
+    }
+
+    trace::put_u16(count, (out - start) / 4);
+    cursor_ = out;
+    cycle_++;
+}
+
+#endif
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+#include "analysis.hpp"
+#include "trace.hpp"
+
+namespace {
+
+struct Hex {
+    int value;
+    int width;
+};
+
+std::ostream &operator<<(std::ostream &os, const Hex &hex) {
+    const auto flags = os.flags();
+    os << "0x" << std::hex << std::uppercase << std::setw(hex.width) << std::setfill('0') << hex.value;
+    os.flags(flags);
+    return os;
+}
+
+std::ostream &operator<<(std::ostream &os, const trace::Record &record) {
+    os << record.cycle << " pc " << Hex{record.pc, 3} << " op " << Hex{record.opcode, 4} << " "
+       << analysis::disassemble(record.opcode);
+    for (const auto &delta : record.deltas) {
+        os << " [" << Hex{delta.address, 3} << "]=" << Hex{delta.value, 2};
+    }
+    return os;
+}
+
+bool is_jump(const std::uint16_t opcode) {
+    switch (opcode & 0xF000) {
+        case 0x0000:
+            return opcode != 0x00E0 && opcode != 0x00EE;
+        case 0x1000:
+        case 0xB000:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int calls(const char *path) {
+    TraceReader reader(path);
+    trace::Record record;
+
+    std::vector<std::uint16_t> stack = {0x200};
+    std::map<std::uint16_t, std::uint64_t> self;
+    std::map<std::pair<std::uint16_t, std::uint16_t>, std::uint64_t> edges;
+
+    while (reader.next(record)) {
+        self[stack.back()]++;
+
+        if ((record.opcode & 0xF000) == 0x2000) {
+            const std::uint16_t target = record.opcode & 0x0FFF;
+            edges[{stack.back(), target}]++;
+            stack.push_back(target);
+        } else if (record.opcode == 0x00EE && stack.size() > 1) {
+            stack.pop_back();
+        }
+    }
+
+    std::cout << "Functions (entry, instructions executed)" << std::endl;
+    for (const auto &[entry, count] : self) {
+        std::cout << "  " << Hex{entry, 3} << " " << count << std::endl;
+    }
+
+    std::cout << "Calls (caller -> callee, count)" << std::endl;
+    for (const auto &[edge, count] : edges) {
+        std::cout << "  " << Hex{edge.first, 3} << " -> " << Hex{edge.second, 3} << " " << count << std::endl;
+    }
+
+    return 0;
+}
+
+int loops(const char *path) {
+    struct Loop {
+        std::uint16_t header;
+        std::uint16_t latch;
+        std::uint64_t iterations = 0;
+        std::uint64_t first = 0;
+        std::uint64_t last = 0;
+    };
+
+    TraceReader reader(path);
+    trace::Record prev;
+    trace::Record record;
+    std::map<std::pair<std::uint16_t, std::uint16_t>, Loop> found;
+
+    if (!reader.next(prev)) {
+        return 0;
+    }
+
+    // A loop is a jump that lands at or before itself
+    while (reader.next(record)) {
+        if (is_jump(prev.opcode) && record.pc <= prev.pc) {
+            auto &loop = found[{record.pc, prev.pc}];
+            if (loop.iterations == 0) {
+                loop.header = record.pc;
+                loop.latch = prev.pc;
+                loop.first = prev.cycle;
+            }
+            loop.iterations++;
+            loop.last = prev.cycle;
+        }
+        std::swap(prev, record);
+    }
+
+    std::vector<Loop> sorted;
+    for (const auto &[key, loop] : found) {
+        sorted.push_back(loop);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Loop &a, const Loop &b) {
+        return a.iterations > b.iterations;
+    });
+
+    std::cout << "Loops (header, latch, iterations, cycles first-last)" << std::endl;
+    for (const auto &loop : sorted) {
+        std::cout << "  " << Hex{loop.header, 3} << " " << Hex{loop.latch, 3} << " " << loop.iterations << " "
+                  << loop.first << "-" << loop.last;
+        if (loop.header == loop.latch) {
+            std::cout << " (spin)";
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
+int diff(const char *path_a, const char *path_b) {
+    // How many matching records to show before the divergence
+    constexpr std::size_t context = 8;
+
+    TraceReader reader_a(path_a);
+    TraceReader reader_b(path_b);
+    trace::Record a;
+    trace::Record b;
+    std::deque<trace::Record> history;
+
+    while (true) {
+        const bool more_a = reader_a.next(a);
+        const bool more_b = reader_b.next(b);
+
+        if (!more_a && !more_b) {
+            std::cout << "Traces match" << std::endl;
+            return 0;
+        }
+
+        if (more_a && more_b && a.pc == b.pc && a.opcode == b.opcode && a.deltas == b.deltas) {
+            history.push_back(a);
+            if (history.size() > context) {
+                history.pop_front();
+            }
+            continue;
+        }
+
+        std::cout << "Traces diverge" << std::endl;
+        for (const auto &record : history) {
+            std::cout << "    " << record << std::endl;
+        }
+        if (more_a) {
+            std::cout << "  a " << a << std::endl;
+        } else {
+            std::cout << "  a ends" << std::endl;
+        }
+        if (more_b) {
+            std::cout << "  b " << b << std::endl;
+        } else {
+            std::cout << "  b ends" << std::endl;
+        }
+        return 1;
+    }
+}
+
+void usage() {
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  trace calls <trace>" << std::endl;
+    std::cout << "  trace loops <trace>" << std::endl;
+    std::cout << "  trace diff <trace a> <trace b>" << std::endl;
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    try {
+        if (argc == 3 && std::strcmp(argv[1], "calls") == 0) {
+            return calls(argv[2]);
+        } else if (argc == 3 && std::strcmp(argv[1], "loops") == 0) {
+            return loops(argv[2]);
+        } else if (argc == 4 && std::strcmp(argv[1], "diff") == 0) {
+            return diff(argv[2], argv[3]);
+        }
+    } catch (const std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        return 2;
+    }
+
+    usage();
+    return 1;
+}
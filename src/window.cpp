@@ -13,11 +13,23 @@ Window::Window(const char *title, const int w, const int h) : width_(w), height_
                                width_,
                                height_,
                                SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
+    // Headless video drivers such as "dummy" can't do OpenGL
+    if (!window_) {
+        window_ = SDL_CreateWindow(title,
+                                   SDL_WINDOWPOS_UNDEFINED,
+                                   SDL_WINDOWPOS_UNDEFINED,
+                                   width_,
+                                   height_,
+                                   SDL_WINDOW_RESIZABLE);
+    }
     if (!window_) {
         throw std::bad_alloc();
     }
 
     renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer_) {
+        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!renderer_) {
         throw std::bad_alloc();
     }
@@ -116,6 +128,69 @@ void Window::render_inputs(const Chip8 &chip8) {
     }
 }
 
+void Window::render_debugger(const Chip8 &chip8, const Debugger &debugger) {
+    assert(window_);
+    assert(renderer_);
+
+    // Each character is a 4x5 font sprite drawn at 2x
+    const int advance = 10;
+    const int line = 14;
+    const int width = 23 * advance + 8;
+    const int height = 4 * line + 6;
+    const int left = width_ - width;
+
+    // Red background when stopped by the debugger
+    if (debugger.hit()) {
+        SDL_SetRenderDrawColor(renderer_, 150, 0, 0, 200);
+    } else {
+        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 200);
+    }
+    const auto rect = SDL_Rect(left, 0, width, height);
+    SDL_RenderFillRect(renderer_, &rect);
+
+    const int x = left + 4;
+    const int y = 4;
+    const std::uint16_t opcode = (chip8.ram()[chip8.pc() & 0xFFF] << 8) + chip8.ram()[(chip8.pc() + 1) & 0xFFF];
+
+    // PC, I, SP, opcode at PC
+    if (debugger.breakpoint(chip8.pc())) {
+        SDL_SetRenderDrawColor(renderer_, 255, 80, 80, 255);
+    } else {
+        SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
+    }
+    render_hex(x, y, chip8.pc(), 3);
+    SDL_SetRenderDrawColor(renderer_, 255, 255, 255, 255);
+    render_hex(x + 4 * advance, y, chip8.i(), 3);
+    render_hex(x + 8 * advance, y, chip8.sp(), 3);
+    render_hex(x + 12 * advance, y, opcode, 4);
+
+    // V0-V7, V8-VF
+    for (int v = 0; v < 16; ++v) {
+        render_hex(x + (v % 8) * 3 * advance, y + (1 + v / 8) * line, chip8.v(v), 2);
+    }
+
+    // DT, ST
+    render_hex(x, y + 3 * line, chip8.dt(), 2);
+    render_hex(x + 3 * advance, y + 3 * line, chip8.st(), 2);
+}
+
+void Window::render_hex(const int x, const int y, const int value, const int digits) {
+    for (int d = 0; d < digits; ++d) {
+        const int digit = (value >> (4 * (digits - d - 1))) & 0xF;
+
+        for (int row = 0; row < 5; ++row) {
+            const std::uint8_t bits = fontset[5 * digit + row];
+
+            for (int col = 0; col < 4; ++col) {
+                if ((bits >> (7 - col)) & 1) {
+                    const auto rect = SDL_Rect(x + 10 * d + 2 * col, y + 2 * row, 2, 2);
+                    SDL_RenderFillRect(renderer_, &rect);
+                }
+            }
+        }
+    }
+}
+
 void Window::present() {
     SDL_RenderPresent(renderer_);
 }
@@ -3,6 +3,7 @@
 
 #include <SDL.h>
 #include "chip8.hpp"
+#include "debugger.hpp"
 
 class Window {
    public:
@@ -18,11 +19,15 @@ class Window {
 
     void render_inputs(const Chip8 &chip8);
 
+    void render_debugger(const Chip8 &chip8, const Debugger &debugger);
+
     void present();
 
     void toggle_fullscreen();
 
    private:
+    void render_hex(const int x, const int y, const int value, const int digits);
+
     int width_ = 1024;
     int height_ = 512;
     bool fullscreen_ = false;
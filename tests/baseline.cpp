@@ -0,0 +1,38 @@
+#include "baseline.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace baseline {
+
+Values read(const std::filesystem::path &path) {
+    Values values;
+    std::ifstream file(path);
+    std::string name;
+    double value = 0;
+    while (file >> name >> value) {
+        values[name] = value;
+    }
+    return values;
+}
+
+bool write(const std::filesystem::path &path, const Values &values) {
+    std::error_code error;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path);
+    file.precision(12);
+    for (const auto &[name, value] : values) {
+        file << name << ' ' << value << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+bool update() {
+    const char *update = std::getenv("CHIP8_PERF_UPDATE");
+    return update && std::strcmp(update, "1") == 0;
+}
+
+}  // namespace baseline
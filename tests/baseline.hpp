@@ -0,0 +1,29 @@
+#ifndef BASELINE_HPP
+#define BASELINE_HPP
+
+#include <filesystem>
+#include <map>
+#include <string>
+
+// Timings stored per machine and build type for the timed tests to compare against,
+// one "name value" pair per line
+namespace baseline {
+
+using Values = std::map<std::string, double>;
+
+// Exit status when there was no baseline to compare against and one was recorded
+// instead, the timed tests register it as their SKIP_RETURN_CODE
+constexpr int missing = 77;
+
+// Empty if the file doesn't exist yet
+[[nodiscard]] Values read(const std::filesystem::path &path);
+
+// Creates the directory if needed
+bool write(const std::filesystem::path &path, const Values &values);
+
+// Whether CHIP8_PERF_UPDATE=1 asks for stored values to be replaced
+[[nodiscard]] bool update();
+
+}  // namespace baseline
+
+#endif
@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "chip8.hpp"
+#include "engine.hpp"
+#include "lockstep.hpp"
+
+namespace {
+
+// ADD V1, 3 this many times then a jump to itself
+constexpr int adds = 500;
+constexpr std::uint64_t instructions = 600;
+constexpr std::uint64_t interval = 100;
+
+// Matches the reference except that it overwrites the byte at 0x200 once it has
+// run the instruction at a chosen index, which in the program above is never run again
+class Broken final : public Engine {
+   public:
+    explicit Broken(const std::uint64_t bad) : bad_(bad) {
+    }
+
+    std::string name() const override {
+        return "broken";
+    }
+
+    void set_state(const Chip8 &chip8) override {
+        chip8_ = chip8;
+    }
+
+    Chip8 state() const override {
+        return chip8_;
+    }
+
+    std::uint64_t digest() const override {
+        return chip8_.digest();
+    }
+
+    bool valid() const override {
+        return chip8_.valid();
+    }
+
+    void step() override {
+        const bool bad = chip8_.pc() == 0x200 + 2 * bad_;
+        chip8_.step();
+        if (bad) {
+            constexpr std::uint8_t junk[] = {0xAB};
+            chip8_.load(junk);
+        }
+    }
+
+    void timers() override {
+        chip8_.timers();
+    }
+
+    void set_keys(const std::uint16_t mask) override {
+        for (int i = 0; i < 16; ++i) {
+            chip8_.set_key(static_cast<Input>(i), (mask >> i) & 1);
+        }
+    }
+
+   private:
+    std::uint64_t bad_;
+    Chip8 chip8_;
+};
+
+Chip8 program() {
+    std::vector<std::uint8_t> rom;
+    for (int i = 0; i < adds; ++i) {
+        rom.push_back(0x71);
+        rom.push_back(0x03);
+    }
+    const int end = 0x200 + 2 * adds;
+    rom.push_back(0x10 | (end >> 8));
+    rom.push_back(end & 0xFF);
+
+    Chip8 chip8;
+    chip8.load(rom);
+    return chip8;
+}
+
+bool expect(const bool ok, const std::uint64_t bad, const char *what) {
+    if (!ok) {
+        std::printf("broken at %llu: %s\n", static_cast<unsigned long long>(bad), what);
+    }
+    return ok;
+}
+
+// Whether lockstep pins the breakage on instruction bad
+bool check(const std::uint64_t bad) {
+    const auto reference = make_reference();
+    Broken candidate(bad);
+    const auto result = lockstep::run(*reference, candidate, program(), [](std::uint64_t) { return 0; }, instructions, interval);
+
+    if (!expect(result.divergence.has_value(), bad, "no divergence found")) {
+        return false;
+    }
+
+    const auto &divergence = *result.divergence;
+    const int pc = 0x200 + 2 * bad;
+    bool ok = true;
+    ok &= expect(divergence.instruction == bad, bad, "wrong instruction index");
+    ok &= expect(result.executed == bad, bad, "wrong executed count");
+    ok &= expect(divergence.before.pc() == pc, bad, "before has the wrong PC");
+    ok &= expect(divergence.before.v(1) == ((3 * bad) & 0xFF), bad, "before has the wrong V1");
+    ok &= expect(divergence.reference.pc() == pc + 2, bad, "reference has the wrong PC");
+    ok &= expect(divergence.reference.ram()[0x200] == 0x71, bad, "reference RAM changed");
+    ok &= expect(divergence.candidate.ram()[0x200] == 0xAB, bad, "candidate RAM unchanged");
+
+    const std::string report = lockstep::describe(candidate.name(), divergence);
+    ok &= expect(report.find("broken diverges at instruction " + std::to_string(bad) + "\n") != std::string::npos,
+                 bad,
+                 "report has the wrong instruction");
+    ok &= expect(report.find("ADD V1") != std::string::npos, bad, "report has the wrong disassembly");
+    ok &= expect(report.find("[200]") != std::string::npos, bad, "report is missing the RAM difference");
+    ok &= expect(report.find("V1 ") == std::string::npos, bad, "report lists a register that agrees");
+
+    if (!ok) {
+        std::cout << report;
+    }
+    return ok;
+}
+
+// Whether an engine that never breaks runs to the end without a divergence
+bool check_clean() {
+    const auto reference = make_reference();
+    Broken candidate(adds + 1);
+    const auto result = lockstep::run(*reference, candidate, program(), [](std::uint64_t) { return 0; }, instructions, interval);
+
+    bool ok = true;
+    ok &= expect(!result.divergence, adds + 1, "divergence found");
+    ok &= expect(result.executed == instructions, adds + 1, "stopped early");
+    return ok;
+}
+
+}  // namespace
+
+int main() {
+    int failures = 0;
+
+    // Start, middle of an interval, either side of an interval boundary and the last add
+    for (const std::uint64_t bad : {0, 1, 333, 99, 100, 101, adds - 1}) {
+        failures += !check(bad);
+    }
+    failures += !check_clean();
+
+    return failures == 0 ? 0 : 1;
+}
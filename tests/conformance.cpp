@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "chip8.hpp"
+#include "roms.hpp"
+
+namespace {
+
+// Matches Application: 500hz CPU, timers every 16ms
+constexpr int steps_per_frame = 8;
+
+Chip8 run(const roms::Case &test) {
+    Chip8 chip8;
+    chip8.load(test.rom);
+
+    for (int frame = 0; frame < test.frames; ++frame) {
+        const std::uint16_t keys = test.keys(frame);
+        for (int i = 0; i < 16; ++i) {
+            chip8.set_key(static_cast<Input>(i), (keys >> i) & 1);
+        }
+        for (int i = 0; i < steps_per_frame && chip8.valid(); ++i) {
+            chip8.step();
+        }
+        chip8.timers();
+    }
+
+    return chip8;
+}
+
+void print(const Chip8 &chip8) {
+    for (int y = 0; y < 32; ++y) {
+        std::string line;
+        for (int x = 0; x < 64; ++x) {
+            line += chip8.pixel(x, y) ? '#' : '.';
+        }
+        std::cout << line << std::endl;
+    }
+    std::printf("display 0x%016llX st %d pc %03X\n",
+                static_cast<unsigned long long>(roms::hash(chip8.display())),
+                chip8.st(),
+                chip8.pc());
+}
+
+bool check(const roms::Case &test, const bool verbose) {
+    const Chip8 chip8 = run(test);
+    const std::uint64_t display = roms::hash(chip8.display());
+    const bool ok = display == test.display && chip8.st() == test.st;
+
+    if (verbose || !ok) {
+        std::cout << test.name << (ok ? "" : " FAILED") << std::endl;
+        print(chip8);
+    }
+    if (!ok) {
+        std::printf("expected display 0x%016llX st %d\n",
+                    static_cast<unsigned long long>(test.display),
+                    test.st);
+    }
+
+    return ok;
+}
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    bool verbose = false;
+    int failures = 0;
+    int ran = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--print") == 0) {
+            verbose = true;
+            continue;
+        }
+
+        bool found = false;
+        for (const auto &test : roms::cases()) {
+            if (test.name == std::string(argv[i])) {
+                failures += !check(test, verbose);
+                ran++;
+                found = true;
+            }
+        }
+        if (!found) {
+            std::cerr << "Unknown case " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    // No names runs everything
+    if (ran == 0) {
+        for (const auto &test : roms::cases()) {
+            failures += !check(test, verbose);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "baseline.hpp"
+#include "chip8.hpp"
+#include "roms.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Matches Application: 500hz CPU, timers every 16ms
+constexpr int steps_per_frame = 8;
+
+// Best of several runs, the slower ones are other things happening on the machine
+constexpr int runs = 5;
+
+struct Measure {
+    const char *name;
+    // Whether bigger numbers are better
+    bool higher;
+    double (*run)();
+};
+
+double instructions_per_second() {
+    constexpr std::uint64_t instructions = 20000000;
+
+    Chip8 chip8;
+    chip8.load(roms::busy());
+
+    const auto start = Clock::now();
+    for (std::uint64_t i = 0; i < instructions; ++i) {
+        chip8.step();
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return instructions / elapsed.count();
+}
+
+double ns_per_frame() {
+    constexpr int frames = 1000000;
+
+    Chip8 chip8;
+    chip8.load(roms::draw());
+
+    const auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < steps_per_frame; ++i) {
+            chip8.step();
+        }
+        chip8.timers();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+    return elapsed.count() / frames;
+}
+
+constexpr Measure measures[] = {
+    {"instructions_per_second", true, instructions_per_second},
+    {"ns_per_frame", false, ns_per_frame},
+};
+
+}  // namespace
+
+int main(const int argc, const char **argv) {
+    const char *name = nullptr;
+    const char *path = nullptr;
+    double tolerance = 0.25;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+                tolerance = std::stod(argv[i + 1]) / 100;
+                i++;
+            } else if (!name) {
+                name = argv[i];
+            } else if (!path) {
+                path = argv[i];
+            } else {
+                name = nullptr;
+                break;
+            }
+        }
+    } catch (const std::exception &) {
+        name = nullptr;
+    }
+
+    const auto measure = std::find_if(std::begin(measures), std::end(measures), [name](const Measure &m) {
+        return name && std::strcmp(m.name, name) == 0;
+    });
+
+    if (measure == std::end(measures) || !path) {
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  perf <measure> <baseline file> [--tolerance <percent>]" << std::endl;
+        std::cout << "Measures:" << std::endl;
+        for (const auto &m : measures) {
+            std::cout << "  " << m.name << std::endl;
+        }
+        std::cout << "Set CHIP8_PERF_UPDATE=1 to replace the stored baseline" << std::endl;
+        return 2;
+    }
+
+    double best = measure->run();
+    for (int i = 1; i < runs; ++i) {
+        const double value = measure->run();
+        best = measure->higher ? std::max(best, value) : std::min(best, value);
+    }
+
+    auto values = baseline::read(path);
+    const auto stored = values.find(measure->name);
+
+    if (stored == values.end() || baseline::update()) {
+        const bool missing = stored == values.end();
+        values[measure->name] = best;
+        if (!baseline::write(path, values)) {
+            std::cerr << "Failed to write baseline " << path << std::endl;
+            return 2;
+        }
+        // Nothing was compared, don't let that pass for a pass unless it was asked for
+        if (missing && !baseline::update()) {
+            std::printf("%s %.1f, no baseline, recorded in %s\n", measure->name, best, path);
+            return baseline::missing;
+        }
+        std::printf("%s %.1f, recorded as the baseline in %s\n", measure->name, best, path);
+        return 0;
+    }
+
+    const double expected = stored->second;
+    const double limit = measure->higher ? expected * (1 - tolerance) : expected * (1 + tolerance);
+    const bool ok = measure->higher ? best >= limit : best <= limit;
+
+    std::printf("%s %.1f, baseline %.1f, limit %.1f (%+.1f%%)\n",
+                measure->name,
+                best,
+                expected,
+                limit,
+                100 * (best - expected) / expected);
+
+    if (!ok) {
+        std::cout << "Regressed past the baseline in " << path << std::endl;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,596 @@
+#include "roms.hpp"
+
+namespace roms {
+
+namespace {
+
+// Each line is commented with its address and the source it was assembled from
+
+// 1nnn, 2nnn, 00EE, 3xkk, 4xkk, 5xy0, 9xy0, Bnnn and 0nnn
+constexpr std::uint8_t flow[] = {
+    0x6E, 0x01,  // 200: LD VE, 1
+    0x12, 0x06,  // 202: JP j1
+    0x12, 0x7A,  // 204: JP fail
+    0x6E, 0x02,  // 206: LD VE, 2
+    0x22, 0x5E,  // 208: CALL sub
+    0x30, 0x42,  // 20A: SE V0, 0x42
+    0x12, 0x7A,  // 20C: JP fail
+    0x6E, 0x03,  // 20E: LD VE, 3
+    0x61, 0x07,  // 210: LD V1, 7
+    0x31, 0x07,  // 212: SE V1, 7
+    0x12, 0x7A,  // 214: JP fail
+    0x31, 0x08,  // 216: SE V1, 8
+    0x12, 0x1C,  // 218: JP ok3
+    0x12, 0x7A,  // 21A: JP fail
+    0x6E, 0x04,  // 21C: LD VE, 4
+    0x41, 0x08,  // 21E: SNE V1, 8
+    0x12, 0x7A,  // 220: JP fail
+    0x41, 0x07,  // 222: SNE V1, 7
+    0x12, 0x28,  // 224: JP ok4
+    0x12, 0x7A,  // 226: JP fail
+    0x6E, 0x05,  // 228: LD VE, 5
+    0x62, 0x07,  // 22A: LD V2, 7
+    0x51, 0x20,  // 22C: SE V1, V2
+    0x12, 0x7A,  // 22E: JP fail
+    0x6E, 0x06,  // 230: LD VE, 6
+    0x91, 0x20,  // 232: SNE V1, V2
+    0x12, 0x38,  // 234: JP ok6
+    0x12, 0x7A,  // 236: JP fail
+    0x6E, 0x07,  // 238: LD VE, 7
+    0x62, 0x09,  // 23A: LD V2, 9
+    0x91, 0x20,  // 23C: SNE V1, V2
+    0x12, 0x7A,  // 23E: JP fail
+    0x6E, 0x08,  // 240: LD VE, 8
+    0x60, 0x04,  // 242: LD V0, 4
+    0xB2, 0x46,  // 244: JP V0, table
+    0x12, 0x7A,  // 246: JP fail
+    0x12, 0x7A,  // 248: JP fail
+    0x12, 0x4C,  // 24A: JP ok8
+    0x6E, 0x09,  // 24C: LD VE, 9
+    0x02, 0x52,  // 24E: SYS ok9
+    0x12, 0x7A,  // 250: JP fail
+    0x6E, 0x0A,  // 252: LD VE, 10
+    0x63, 0x00,  // 254: LD V3, 0
+    0x22, 0x64,  // 256: CALL nested
+    0x33, 0x02,  // 258: SE V3, 2
+    0x12, 0x7A,  // 25A: JP fail
+    0x12, 0x6A,  // 25C: JP pass
+    0x60, 0x42,  // 25E: LD V0, 0x42
+    0x73, 0x01,  // 260: ADD V3, 1
+    0x00, 0xEE,  // 262: RET
+    0x22, 0x5E,  // 264: CALL sub
+    0x73, 0x01,  // 266: ADD V3, 1
+    0x00, 0xEE,  // 268: RET
+    0x60, 0x00,  // 26A: LD V0, 0
+    0x61, 0x00,  // 26C: LD V1, 0
+    0x62, 0x00,  // 26E: LD V2, 0
+    0xF0, 0x29,  // 270: LD F, V0
+    0xD1, 0x25,  // 272: DRW V1, V2, 5
+    0x61, 0x05,  // 274: LD V1, 5
+    0xD1, 0x25,  // 276: DRW V1, V2, 5
+    0x12, 0x78,  // 278: JP pass_end
+    0x61, 0x00,  // 27A: LD V1, 0
+    0x62, 0x00,  // 27C: LD V2, 0
+    0x60, 0x0F,  // 27E: LD V0, 0xF
+    0xF0, 0x29,  // 280: LD F, V0
+    0xD1, 0x25,  // 282: DRW V1, V2, 5
+    0x80, 0xE0,  // 284: LD V0, VE
+    0x80, 0x06,  // 286: SHR V0, V0
+    0x80, 0x06,  // 288: SHR V0, V0
+    0x80, 0x06,  // 28A: SHR V0, V0
+    0x80, 0x06,  // 28C: SHR V0, V0
+    0xF0, 0x29,  // 28E: LD F, V0
+    0x61, 0x0A,  // 290: LD V1, 10
+    0xD1, 0x25,  // 292: DRW V1, V2, 5
+    0x80, 0xE0,  // 294: LD V0, VE
+    0x63, 0x0F,  // 296: LD V3, 0x0F
+    0x80, 0x32,  // 298: AND V0, V3
+    0xF0, 0x29,  // 29A: LD F, V0
+    0x61, 0x0F,  // 29C: LD V1, 15
+    0xD1, 0x25,  // 29E: DRW V1, V2, 5
+    0x12, 0xA0,  // 2A0: JP fail_end
+};
+
+// 6xkk, 7xkk, 8xy0 to 8xyE with VF, and Cxkk masking
+constexpr std::uint8_t alu[] = {
+    0x60, 0x12,  // 200: LD V0, 0x12
+    0x6E, 0x01,  // 202: LD VE, 1
+    0x30, 0x12,  // 204: SE V0, 0x12
+    0x12, 0xE6,  // 206: JP fail
+    0x6F, 0x05,  // 208: LD VF, 5
+    0x70, 0xF0,  // 20A: ADD V0, 0xF0
+    0x6E, 0x02,  // 20C: LD VE, 2
+    0x30, 0x02,  // 20E: SE V0, 0x02
+    0x12, 0xE6,  // 210: JP fail
+    0x6E, 0x03,  // 212: LD VE, 3
+    0x3F, 0x05,  // 214: SE VF, 5
+    0x12, 0xE6,  // 216: JP fail
+    0x81, 0x00,  // 218: LD V1, V0
+    0x6E, 0x04,  // 21A: LD VE, 4
+    0x31, 0x02,  // 21C: SE V1, 0x02
+    0x12, 0xE6,  // 21E: JP fail
+    0x60, 0xF0,  // 220: LD V0, 0xF0
+    0x61, 0x0F,  // 222: LD V1, 0x0F
+    0x80, 0x11,  // 224: OR V0, V1
+    0x6E, 0x05,  // 226: LD VE, 5
+    0x30, 0xFF,  // 228: SE V0, 0xFF
+    0x12, 0xE6,  // 22A: JP fail
+    0x60, 0x3C,  // 22C: LD V0, 0x3C
+    0x80, 0x12,  // 22E: AND V0, V1
+    0x6E, 0x06,  // 230: LD VE, 6
+    0x30, 0x0C,  // 232: SE V0, 0x0C
+    0x12, 0xE6,  // 234: JP fail
+    0x60, 0x3C,  // 236: LD V0, 0x3C
+    0x80, 0x13,  // 238: XOR V0, V1
+    0x6E, 0x07,  // 23A: LD VE, 7
+    0x30, 0x33,  // 23C: SE V0, 0x33
+    0x12, 0xE6,  // 23E: JP fail
+    0x60, 0xF0,  // 240: LD V0, 0xF0
+    0x61, 0x20,  // 242: LD V1, 0x20
+    0x80, 0x14,  // 244: ADD V0, V1
+    0x6E, 0x08,  // 246: LD VE, 8
+    0x30, 0x10,  // 248: SE V0, 0x10
+    0x12, 0xE6,  // 24A: JP fail
+    0x6E, 0x09,  // 24C: LD VE, 9
+    0x3F, 0x01,  // 24E: SE VF, 1
+    0x12, 0xE6,  // 250: JP fail
+    0x80, 0x14,  // 252: ADD V0, V1
+    0x6E, 0x0A,  // 254: LD VE, 10
+    0x30, 0x30,  // 256: SE V0, 0x30
+    0x12, 0xE6,  // 258: JP fail
+    0x6E, 0x0B,  // 25A: LD VE, 11
+    0x3F, 0x00,  // 25C: SE VF, 0
+    0x12, 0xE6,  // 25E: JP fail
+    0x61, 0x10,  // 260: LD V1, 0x10
+    0x80, 0x15,  // 262: SUB V0, V1
+    0x6E, 0x0C,  // 264: LD VE, 12
+    0x30, 0x20,  // 266: SE V0, 0x20
+    0x12, 0xE6,  // 268: JP fail
+    0x6E, 0x0D,  // 26A: LD VE, 13
+    0x3F, 0x01,  // 26C: SE VF, 1
+    0x12, 0xE6,  // 26E: JP fail
+    0x81, 0x05,  // 270: SUB V1, V0
+    0x6E, 0x0E,  // 272: LD VE, 14
+    0x31, 0xF0,  // 274: SE V1, 0xF0
+    0x12, 0xE6,  // 276: JP fail
+    0x6E, 0x0F,  // 278: LD VE, 15
+    0x3F, 0x00,  // 27A: SE VF, 0
+    0x12, 0xE6,  // 27C: JP fail
+    0x60, 0x05,  // 27E: LD V0, 0x05
+    0x80, 0x06,  // 280: SHR V0, V0
+    0x6E, 0x10,  // 282: LD VE, 16
+    0x30, 0x02,  // 284: SE V0, 0x02
+    0x12, 0xE6,  // 286: JP fail
+    0x6E, 0x11,  // 288: LD VE, 17
+    0x3F, 0x01,  // 28A: SE VF, 1
+    0x12, 0xE6,  // 28C: JP fail
+    0x60, 0x10,  // 28E: LD V0, 0x10
+    0x61, 0x30,  // 290: LD V1, 0x30
+    0x80, 0x17,  // 292: SUBN V0, V1
+    0x6E, 0x12,  // 294: LD VE, 18
+    0x30, 0x20,  // 296: SE V0, 0x20
+    0x12, 0xE6,  // 298: JP fail
+    0x6E, 0x13,  // 29A: LD VE, 19
+    0x3F, 0x01,  // 29C: SE VF, 1
+    0x12, 0xE6,  // 29E: JP fail
+    0x61, 0x10,  // 2A0: LD V1, 0x10
+    0x80, 0x17,  // 2A2: SUBN V0, V1
+    0x6E, 0x14,  // 2A4: LD VE, 20
+    0x30, 0xF0,  // 2A6: SE V0, 0xF0
+    0x12, 0xE6,  // 2A8: JP fail
+    0x6E, 0x15,  // 2AA: LD VE, 21
+    0x3F, 0x00,  // 2AC: SE VF, 0
+    0x12, 0xE6,  // 2AE: JP fail
+    0x60, 0x81,  // 2B0: LD V0, 0x81
+    0x80, 0x0E,  // 2B2: SHL V0, V0
+    0x6E, 0x16,  // 2B4: LD VE, 22
+    0x30, 0x02,  // 2B6: SE V0, 0x02
+    0x12, 0xE6,  // 2B8: JP fail
+    0x6E, 0x17,  // 2BA: LD VE, 23
+    0x3F, 0x01,  // 2BC: SE VF, 1
+    0x12, 0xE6,  // 2BE: JP fail
+    0xC0, 0x00,  // 2C0: RND V0, 0x00
+    0x6E, 0x18,  // 2C2: LD VE, 24
+    0x30, 0x00,  // 2C4: SE V0, 0
+    0x12, 0xE6,  // 2C6: JP fail
+    0xC0, 0x0F,  // 2C8: RND V0, 0x0F
+    0x61, 0xF0,  // 2CA: LD V1, 0xF0
+    0x81, 0x02,  // 2CC: AND V1, V0
+    0x6E, 0x19,  // 2CE: LD VE, 25
+    0x31, 0x00,  // 2D0: SE V1, 0
+    0x12, 0xE6,  // 2D2: JP fail
+    0x12, 0xD6,  // 2D4: JP pass
+    0x60, 0x00,  // 2D6: LD V0, 0
+    0x61, 0x00,  // 2D8: LD V1, 0
+    0x62, 0x00,  // 2DA: LD V2, 0
+    0xF0, 0x29,  // 2DC: LD F, V0
+    0xD1, 0x25,  // 2DE: DRW V1, V2, 5
+    0x61, 0x05,  // 2E0: LD V1, 5
+    0xD1, 0x25,  // 2E2: DRW V1, V2, 5
+    0x12, 0xE4,  // 2E4: JP pass_end
+    0x61, 0x00,  // 2E6: LD V1, 0
+    0x62, 0x00,  // 2E8: LD V2, 0
+    0x60, 0x0F,  // 2EA: LD V0, 0xF
+    0xF0, 0x29,  // 2EC: LD F, V0
+    0xD1, 0x25,  // 2EE: DRW V1, V2, 5
+    0x80, 0xE0,  // 2F0: LD V0, VE
+    0x80, 0x06,  // 2F2: SHR V0, V0
+    0x80, 0x06,  // 2F4: SHR V0, V0
+    0x80, 0x06,  // 2F6: SHR V0, V0
+    0x80, 0x06,  // 2F8: SHR V0, V0
+    0xF0, 0x29,  // 2FA: LD F, V0
+    0x61, 0x0A,  // 2FC: LD V1, 10
+    0xD1, 0x25,  // 2FE: DRW V1, V2, 5
+    0x80, 0xE0,  // 300: LD V0, VE
+    0x63, 0x0F,  // 302: LD V3, 0x0F
+    0x80, 0x32,  // 304: AND V0, V3
+    0xF0, 0x29,  // 306: LD F, V0
+    0x61, 0x0F,  // 308: LD V1, 15
+    0xD1, 0x25,  // 30A: DRW V1, V2, 5
+    0x13, 0x0C,  // 30C: JP fail_end
+};
+
+// Annn, Fx55, Fx65, Fx33, Fx1E and Fx29, I is left alone by Fx55
+constexpr std::uint8_t memory[] = {
+    0xA2, 0xAC,              // 200: LD I, buf
+    0x60, 0x11,              // 202: LD V0, 0x11
+    0x61, 0x22,              // 204: LD V1, 0x22
+    0x62, 0x33,              // 206: LD V2, 0x33
+    0xF2, 0x55,              // 208: LD [I], V2
+    0x60, 0x00,              // 20A: LD V0, 0
+    0x61, 0x00,              // 20C: LD V1, 0
+    0x62, 0x00,              // 20E: LD V2, 0
+    0xF2, 0x65,              // 210: LD V2, [I]
+    0x6E, 0x01,              // 212: LD VE, 1
+    0x30, 0x11,              // 214: SE V0, 0x11
+    0x12, 0x84,              // 216: JP fail
+    0x6E, 0x02,              // 218: LD VE, 2
+    0x31, 0x22,              // 21A: SE V1, 0x22
+    0x12, 0x84,              // 21C: JP fail
+    0x6E, 0x03,              // 21E: LD VE, 3
+    0x32, 0x33,              // 220: SE V2, 0x33
+    0x12, 0x84,              // 222: JP fail
+    0x63, 0xEA,              // 224: LD V3, 234
+    0xA2, 0xAC,              // 226: LD I, buf
+    0xF3, 0x33,              // 228: LD B, V3
+    0xF2, 0x65,              // 22A: LD V2, [I]
+    0x6E, 0x04,              // 22C: LD VE, 4
+    0x30, 0x02,              // 22E: SE V0, 2
+    0x12, 0x84,              // 230: JP fail
+    0x6E, 0x05,              // 232: LD VE, 5
+    0x31, 0x03,              // 234: SE V1, 3
+    0x12, 0x84,              // 236: JP fail
+    0x6E, 0x06,              // 238: LD VE, 6
+    0x32, 0x04,              // 23A: SE V2, 4
+    0x12, 0x84,              // 23C: JP fail
+    0xA2, 0xAC,              // 23E: LD I, buf
+    0x64, 0x02,              // 240: LD V4, 2
+    0xF4, 0x1E,              // 242: ADD I, V4
+    0xF0, 0x65,              // 244: LD V0, [I]
+    0x6E, 0x07,              // 246: LD VE, 7
+    0x30, 0x04,              // 248: SE V0, 4
+    0x12, 0x84,              // 24A: JP fail
+    0x64, 0x0A,              // 24C: LD V4, 0xA
+    0xF4, 0x29,              // 24E: LD F, V4
+    0xF1, 0x65,              // 250: LD V1, [I]
+    0x6E, 0x08,              // 252: LD VE, 8
+    0x30, 0xF0,              // 254: SE V0, 0xF0
+    0x12, 0x84,              // 256: JP fail
+    0x6E, 0x09,              // 258: LD VE, 9
+    0x31, 0x90,              // 25A: SE V1, 0x90
+    0x12, 0x84,              // 25C: JP fail
+    0x60, 0x55,              // 25E: LD V0, 0x55
+    0xA2, 0xAC,              // 260: LD I, buf
+    0xF0, 0x55,              // 262: LD [I], V0
+    0x60, 0x66,              // 264: LD V0, 0x66
+    0xF0, 0x55,              // 266: LD [I], V0
+    0x60, 0x00,              // 268: LD V0, 0
+    0xF0, 0x65,              // 26A: LD V0, [I]
+    0x6E, 0x0A,              // 26C: LD VE, 10
+    0x30, 0x66,              // 26E: SE V0, 0x66
+    0x12, 0x84,              // 270: JP fail
+    0x12, 0x74,              // 272: JP pass
+    0x60, 0x00,              // 274: LD V0, 0
+    0x61, 0x00,              // 276: LD V1, 0
+    0x62, 0x00,              // 278: LD V2, 0
+    0xF0, 0x29,              // 27A: LD F, V0
+    0xD1, 0x25,              // 27C: DRW V1, V2, 5
+    0x61, 0x05,              // 27E: LD V1, 5
+    0xD1, 0x25,              // 280: DRW V1, V2, 5
+    0x12, 0x82,              // 282: JP pass_end
+    0x61, 0x00,              // 284: LD V1, 0
+    0x62, 0x00,              // 286: LD V2, 0
+    0x60, 0x0F,              // 288: LD V0, 0xF
+    0xF0, 0x29,              // 28A: LD F, V0
+    0xD1, 0x25,              // 28C: DRW V1, V2, 5
+    0x80, 0xE0,              // 28E: LD V0, VE
+    0x80, 0x06,              // 290: SHR V0, V0
+    0x80, 0x06,              // 292: SHR V0, V0
+    0x80, 0x06,              // 294: SHR V0, V0
+    0x80, 0x06,              // 296: SHR V0, V0
+    0xF0, 0x29,              // 298: LD F, V0
+    0x61, 0x0A,              // 29A: LD V1, 10
+    0xD1, 0x25,              // 29C: DRW V1, V2, 5
+    0x80, 0xE0,              // 29E: LD V0, VE
+    0x63, 0x0F,              // 2A0: LD V3, 0x0F
+    0x80, 0x32,              // 2A2: AND V0, V3
+    0xF0, 0x29,              // 2A4: LD F, V0
+    0x61, 0x0F,              // 2A6: LD V1, 15
+    0xD1, 0x25,              // 2A8: DRW V1, V2, 5
+    0x12, 0xAA,              // 2AA: JP fail_end
+    0x00, 0x00, 0x00, 0x00,  // 2AC: DB 0, 0, 0, 0
+};
+
+// Fx15, Fx07 and Fx18, waits for DT to run out then leaves ST counting down
+constexpr std::uint8_t timers[] = {
+    0x60, 0x0A,  // 200: LD V0, 10
+    0xF0, 0x15,  // 202: LD DT, V0
+    0xF1, 0x07,  // 204: LD V1, DT
+    0x6E, 0x01,  // 206: LD VE, 1
+    0x31, 0x0A,  // 208: SE V1, 10
+    0x12, 0x28,  // 20A: JP fail
+    0xF1, 0x07,  // 20C: LD V1, DT
+    0x31, 0x00,  // 20E: SE V1, 0
+    0x12, 0x0C,  // 210: JP wait
+    0x60, 0xC8,  // 212: LD V0, 200
+    0xF0, 0x18,  // 214: LD ST, V0
+    0x12, 0x18,  // 216: JP pass
+    0x60, 0x00,  // 218: LD V0, 0
+    0x61, 0x00,  // 21A: LD V1, 0
+    0x62, 0x00,  // 21C: LD V2, 0
+    0xF0, 0x29,  // 21E: LD F, V0
+    0xD1, 0x25,  // 220: DRW V1, V2, 5
+    0x61, 0x05,  // 222: LD V1, 5
+    0xD1, 0x25,  // 224: DRW V1, V2, 5
+    0x12, 0x26,  // 226: JP pass_end
+    0x61, 0x00,  // 228: LD V1, 0
+    0x62, 0x00,  // 22A: LD V2, 0
+    0x60, 0x0F,  // 22C: LD V0, 0xF
+    0xF0, 0x29,  // 22E: LD F, V0
+    0xD1, 0x25,  // 230: DRW V1, V2, 5
+    0x80, 0xE0,  // 232: LD V0, VE
+    0x80, 0x06,  // 234: SHR V0, V0
+    0x80, 0x06,  // 236: SHR V0, V0
+    0x80, 0x06,  // 238: SHR V0, V0
+    0x80, 0x06,  // 23A: SHR V0, V0
+    0xF0, 0x29,  // 23C: LD F, V0
+    0x61, 0x0A,  // 23E: LD V1, 10
+    0xD1, 0x25,  // 240: DRW V1, V2, 5
+    0x80, 0xE0,  // 242: LD V0, VE
+    0x63, 0x0F,  // 244: LD V3, 0x0F
+    0x80, 0x32,  // 246: AND V0, V3
+    0xF0, 0x29,  // 248: LD F, V0
+    0x61, 0x0F,  // 24A: LD V1, 15
+    0xD1, 0x25,  // 24C: DRW V1, V2, 5
+    0x12, 0x4E,  // 24E: JP fail_end
+};
+
+// ExA1, Fx0A and Ex9E, only the low nibble of Vx picks the key
+constexpr std::uint8_t keys[] = {
+    0x60, 0x05,  // 200: LD V0, 5
+    0x6E, 0x01,  // 202: LD VE, 1
+    0xE0, 0xA1,  // 204: SKNP V0
+    0x12, 0x3E,  // 206: JP fail
+    0x6E, 0x02,  // 208: LD VE, 2
+    0xF1, 0x0A,  // 20A: LD V1, K
+    0x31, 0x05,  // 20C: SE V1, 5
+    0x12, 0x3E,  // 20E: JP fail
+    0x6E, 0x03,  // 210: LD VE, 3
+    0xE0, 0x9E,  // 212: SKP V0
+    0x12, 0x3E,  // 214: JP fail
+    0x6E, 0x04,  // 216: LD VE, 4
+    0x60, 0x15,  // 218: LD V0, 0x15
+    0xE0, 0x9E,  // 21A: SKP V0
+    0x12, 0x3E,  // 21C: JP fail
+    0x6E, 0x05,  // 21E: LD VE, 5
+    0x60, 0x05,  // 220: LD V0, 5
+    0xE0, 0xA1,  // 222: SKNP V0
+    0x12, 0x22,  // 224: JP release
+    0x60, 0x15,  // 226: LD V0, 0x15
+    0xE0, 0xA1,  // 228: SKNP V0
+    0x12, 0x3E,  // 22A: JP fail
+    0x12, 0x2E,  // 22C: JP pass
+    0x60, 0x00,  // 22E: LD V0, 0
+    0x61, 0x00,  // 230: LD V1, 0
+    0x62, 0x00,  // 232: LD V2, 0
+    0xF0, 0x29,  // 234: LD F, V0
+    0xD1, 0x25,  // 236: DRW V1, V2, 5
+    0x61, 0x05,  // 238: LD V1, 5
+    0xD1, 0x25,  // 23A: DRW V1, V2, 5
+    0x12, 0x3C,  // 23C: JP pass_end
+    0x61, 0x00,  // 23E: LD V1, 0
+    0x62, 0x00,  // 240: LD V2, 0
+    0x60, 0x0F,  // 242: LD V0, 0xF
+    0xF0, 0x29,  // 244: LD F, V0
+    0xD1, 0x25,  // 246: DRW V1, V2, 5
+    0x80, 0xE0,  // 248: LD V0, VE
+    0x80, 0x06,  // 24A: SHR V0, V0
+    0x80, 0x06,  // 24C: SHR V0, V0
+    0x80, 0x06,  // 24E: SHR V0, V0
+    0x80, 0x06,  // 250: SHR V0, V0
+    0xF0, 0x29,  // 252: LD F, V0
+    0x61, 0x0A,  // 254: LD V1, 10
+    0xD1, 0x25,  // 256: DRW V1, V2, 5
+    0x80, 0xE0,  // 258: LD V0, VE
+    0x63, 0x0F,  // 25A: LD V3, 0x0F
+    0x80, 0x32,  // 25C: AND V0, V3
+    0xF0, 0x29,  // 25E: LD F, V0
+    0x61, 0x0F,  // 260: LD V1, 15
+    0xD1, 0x25,  // 262: DRW V1, V2, 5
+    0x12, 0x64,  // 264: JP fail_end
+};
+
+// 00E0 and Dxyn collisions, then sprites wrapping off the right and bottom edges
+constexpr std::uint8_t display[] = {
+    0xA2, 0x80,        // 200: LD I, sprite
+    0x60, 0x1E,        // 202: LD V0, 30
+    0x61, 0x0E,        // 204: LD V1, 14
+    0xD0, 0x13,        // 206: DRW V0, V1, 3
+    0x00, 0xE0,        // 208: CLS
+    0x60, 0x04,        // 20A: LD V0, 4
+    0x61, 0x02,        // 20C: LD V1, 2
+    0xD0, 0x13,        // 20E: DRW V0, V1, 3
+    0x6E, 0x01,        // 210: LD VE, 1
+    0x3F, 0x00,        // 212: SE VF, 0
+    0x12, 0x58,        // 214: JP fail
+    0xD0, 0x13,        // 216: DRW V0, V1, 3
+    0x6E, 0x02,        // 218: LD VE, 2
+    0x3F, 0x01,        // 21A: SE VF, 1
+    0x12, 0x58,        // 21C: JP fail
+    0xD0, 0x13,        // 21E: DRW V0, V1, 3
+    0x60, 0x06,        // 220: LD V0, 6
+    0xD0, 0x13,        // 222: DRW V0, V1, 3
+    0x6E, 0x03,        // 224: LD VE, 3
+    0x3F, 0x01,        // 226: SE VF, 1
+    0x12, 0x58,        // 228: JP fail
+    0x60, 0x3C,        // 22A: LD V0, 60
+    0x61, 0x0A,        // 22C: LD V1, 10
+    0xD0, 0x13,        // 22E: DRW V0, V1, 3
+    0x60, 0x14,        // 230: LD V0, 20
+    0x61, 0x1E,        // 232: LD V1, 30
+    0xD0, 0x13,        // 234: DRW V0, V1, 3
+    0x60, 0x48,        // 236: LD V0, 0x48
+    0x61, 0x30,        // 238: LD V1, 0x30
+    0xD0, 0x13,        // 23A: DRW V0, V1, 3
+    0x60, 0x28,        // 23C: LD V0, 40
+    0x61, 0x14,        // 23E: LD V1, 20
+    0x62, 0x0E,        // 240: LD V2, 0xE
+    0xF2, 0x29,        // 242: LD F, V2
+    0xD0, 0x15,        // 244: DRW V0, V1, 5
+    0x12, 0x46,        // 246: JP end
+    0x60, 0x00,        // 248: LD V0, 0
+    0x61, 0x00,        // 24A: LD V1, 0
+    0x62, 0x00,        // 24C: LD V2, 0
+    0xF0, 0x29,        // 24E: LD F, V0
+    0xD1, 0x25,        // 250: DRW V1, V2, 5
+    0x61, 0x05,        // 252: LD V1, 5
+    0xD1, 0x25,        // 254: DRW V1, V2, 5
+    0x12, 0x56,        // 256: JP pass_end
+    0x61, 0x00,        // 258: LD V1, 0
+    0x62, 0x00,        // 25A: LD V2, 0
+    0x60, 0x0F,        // 25C: LD V0, 0xF
+    0xF0, 0x29,        // 25E: LD F, V0
+    0xD1, 0x25,        // 260: DRW V1, V2, 5
+    0x80, 0xE0,        // 262: LD V0, VE
+    0x80, 0x06,        // 264: SHR V0, V0
+    0x80, 0x06,        // 266: SHR V0, V0
+    0x80, 0x06,        // 268: SHR V0, V0
+    0x80, 0x06,        // 26A: SHR V0, V0
+    0xF0, 0x29,        // 26C: LD F, V0
+    0x61, 0x0A,        // 26E: LD V1, 10
+    0xD1, 0x25,        // 270: DRW V1, V2, 5
+    0x80, 0xE0,        // 272: LD V0, VE
+    0x63, 0x0F,        // 274: LD V3, 0x0F
+    0x80, 0x32,        // 276: AND V0, V3
+    0xF0, 0x29,        // 278: LD F, V0
+    0x61, 0x0F,        // 27A: LD V1, 15
+    0xD1, 0x25,        // 27C: DRW V1, V2, 5
+    0x12, 0x7E,        // 27E: JP fail_end
+    0xFF, 0x81, 0xFF,  // 280: DB 0xFF, 0x81, 0xFF
+};
+
+// Every font glyph in two rows
+constexpr std::uint8_t font[] = {
+    0x60, 0x00,  // 200: LD V0, 0
+    0x61, 0x00,  // 202: LD V1, 0
+    0x62, 0x00,  // 204: LD V2, 0
+    0xF2, 0x29,  // 206: LD F, V2
+    0xD0, 0x15,  // 208: DRW V0, V1, 5
+    0x70, 0x05,  // 20A: ADD V0, 5
+    0x72, 0x01,  // 20C: ADD V2, 1
+    0x32, 0x08,  // 20E: SE V2, 8
+    0x12, 0x16,  // 210: JP next
+    0x60, 0x00,  // 212: LD V0, 0
+    0x61, 0x06,  // 214: LD V1, 6
+    0x32, 0x10,  // 216: SE V2, 16
+    0x12, 0x06,  // 218: JP loop
+    0x12, 0x1A,  // 21A: JP end
+};
+
+// Draws "00" then returns with nothing on the stack, valid() has to stop it after that
+constexpr std::uint8_t underflow[] = {
+    0x60, 0x00,  // 200: LD V0, 0
+    0x61, 0x00,  // 202: LD V1, 0
+    0x62, 0x00,  // 204: LD V2, 0
+    0xF0, 0x29,  // 206: LD F, V0
+    0xD1, 0x25,  // 208: DRW V1, V2, 5
+    0x61, 0x05,  // 20A: LD V1, 5
+    0xD1, 0x25,  // 20C: DRW V1, V2, 5
+    0x00, 0xEE,  // 20E: RET
+};
+
+// Never draws or waits on anything
+constexpr std::uint8_t busy_rom[] = {
+    0x70, 0x01,              // 200: ADD V0, 1
+    0x81, 0x04,              // 202: ADD V1, V0
+    0x82, 0x13,              // 204: XOR V2, V1
+    0x83, 0x2E,              // 206: SHL V3, V2
+    0xA2, 0x16,              // 208: LD I, buf
+    0xF3, 0x55,              // 20A: LD [I], V3
+    0xF3, 0x65,              // 20C: LD V3, [I]
+    0x30, 0x00,              // 20E: SE V0, 0
+    0x12, 0x00,              // 210: JP loop
+    0x74, 0x01,              // 212: ADD V4, 1
+    0x12, 0x00,              // 214: JP loop
+    0x00, 0x00, 0x00, 0x00,  // 216: DB 0, 0, 0, 0
+};
+
+// Digits at random x positions, cleared every 16 draws
+constexpr std::uint8_t draw_rom[] = {
+    0x61, 0x00,  // 200: LD V1, 0
+    0x62, 0x00,  // 202: LD V2, 0
+    0xC0, 0x3F,  // 204: RND V0, 0x3F
+    0xF2, 0x29,  // 206: LD F, V2
+    0xD0, 0x15,  // 208: DRW V0, V1, 5
+    0x71, 0x03,  // 20A: ADD V1, 3
+    0x72, 0x01,  // 20C: ADD V2, 1
+    0x32, 0x10,  // 20E: SE V2, 16
+    0x12, 0x04,  // 210: JP loop
+    0x00, 0xE0,  // 212: CLS
+    0x12, 0x00,  // 214: JP start
+};
+
+std::uint16_t no_keys(int) {
+    return 0;
+}
+
+// Key 5 held from frame 20 to 39, long enough for Fx0A to see it and ExA1 to see it go
+std::uint16_t press_5(const int frame) {
+    return frame >= 20 && frame < 40 ? 1 << 5 : 0;
+}
+
+}  // namespace
+
+const std::vector<Case> &cases() {
+    // Expected hashes were taken from a run whose screen was checked by eye,
+    // `conformance --print` shows both
+    static const std::vector<Case> list = {
+        {"flow", flow, 60, no_keys, 0xA0C4643E8D18A7B1, 0},
+        {"alu", alu, 60, no_keys, 0xA0C4643E8D18A7B1, 0},
+        {"memory", memory, 60, no_keys, 0xA0C4643E8D18A7B1, 0},
+        {"timers", timers, 60, no_keys, 0xA0C4643E8D18A7B1, 150},
+        {"keys", keys, 60, press_5, 0xA0C4643E8D18A7B1, 0},
+        {"display", display, 60, no_keys, 0xBA2E637B24B98D40, 0},
+        {"font", font, 60, no_keys, 0xE2384E2D2568B2BC, 0},
+        {"underflow", underflow, 60, no_keys, 0xA0C4643E8D18A7B1, 0},
+    };
+    return list;
+}
+
+std::uint64_t hash(const std::span<const std::uint8_t> bytes) {
+    std::uint64_t hash = 0xCBF29CE484222325;
+    for (const auto byte : bytes) {
+        hash = (hash ^ byte) * 0x100000001B3;
+    }
+    return hash;
+}
+
+std::span<const std::uint8_t> busy() {
+    return busy_rom;
+}
+
+std::span<const std::uint8_t> draw() {
+    return draw_rom;
+}
+
+}  // namespace roms
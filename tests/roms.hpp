@@ -0,0 +1,41 @@
+#ifndef ROMS_HPP
+#define ROMS_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Test ROMs for the CTest suite, written for this repository and under its licence.
+//
+// The conformance ROMs check each result as they go with `LD VE, <check>`,
+// `SE Vx, <expected>`, `JP fail`. On success they draw "00" in the top left
+// corner, on failure "F" followed by the number of the check that failed.
+namespace roms {
+
+struct Case {
+    const char *name;
+    std::span<const std::uint8_t> rom;
+    // Frames to run, each 8 instructions followed by a timer tick
+    int frames;
+    // Key mask held down during a given frame
+    std::uint16_t (*keys)(int frame);
+    // FNV-1a of Chip8::display() after the last frame
+    std::uint64_t display;
+    // Sound timer after the last frame
+    std::uint8_t st;
+};
+
+[[nodiscard]] const std::vector<Case> &cases();
+
+// Hash used for Case::display
+[[nodiscard]] std::uint64_t hash(std::span<const std::uint8_t> bytes);
+
+// Arithmetic and memory in a loop that never draws, for instructions per second
+[[nodiscard]] std::span<const std::uint8_t> busy();
+
+// Draws every digit down the screen and clears, forever, for time per frame
+[[nodiscard]] std::span<const std::uint8_t> draw();
+
+}  // namespace roms
+
+#endif